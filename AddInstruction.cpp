@@ -37,4 +37,8 @@ int AddInstruction::execute(Process& process) {
 
 std::string AddInstruction::toString() const {
     return "ADD " + target;
+}
+
+std::string AddInstruction::toSource() const {
+    return "ADD " + target + " " + operandToSource(op1) + " " + operandToSource(op2);
 }
\ No newline at end of file
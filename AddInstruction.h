@@ -53,6 +53,16 @@ public:
      */
     std::string toString() const override;
 
+
+
+
+    /**
+     * @brief Returns the instruction in the syntax Instruction::fromString parses.
+     *
+     * @return std::string "ADD <target> <op1> <op2>".
+     */
+    std::string toSource() const override;
+
 private:
 	std::string target;                             // Target variable name
 	std::variant<std::string, uint16_t> op1, op2;   // Operands (variable names or immediate values)
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <cstring>
+
+#include "BackingStore.h"
+#include "FileBackingStore.h"
+#include "MappedBackingStore.h"
+
+// Factory for the backing store selected by the "backing-store" config key
+std::unique_ptr<BackingStore> BackingStore::create(const std::string& mode, const std::string& filename, uint32_t pageSize) {
+    if (mode == "mmap")
+        return std::make_unique<MappedBackingStore>(filename, pageSize);
+    return std::make_unique<FileBackingStore>(filename, pageSize);
+}
+
+// Reads a page into dest, returns false if the page has no slot yet
+bool BackingStore::readPage(uint32_t pid, uint32_t vpn, uint8_t* dest) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    auto procIt = slotIndex.find(pid);
+    if (procIt == slotIndex.end()) return false;
+
+    auto pageIt = procIt->second.find(vpn);
+    if (pageIt == procIt->second.end()) return false;
+
+    ensureOpen();
+    readSlot(pageIt->second, dest);
+    return true;
+}
+
+// Writes a page from src, allocating a slot on the first write
+void BackingStore::writePage(uint32_t pid, uint32_t vpn, const uint8_t* src) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    ensureOpen();
+    writeSlot(slotFor(pid, vpn), src);
+}
+
+// C-LOOK order: slots at or past the head first, ascending, then wrapping around to the lowest.
+// Stable so that a page queued twice keeps its newest copy last
+template <typename T>
+static void sortForSweep(std::vector<std::pair<uint32_t, T>>& slots, uint32_t head) {
+    std::stable_sort(slots.begin(), slots.end(), [head](const auto& a, const auto& b) {
+        bool aWrapped = a.first < head;
+        bool bWrapped = b.first < head;
+        if (aWrapped != bWrapped) return bWrapped;
+        return a.first < b.first;
+    });
+}
+
+// Writes a batch of pages, coalescing pages that land in adjacent slots into one run
+size_t BackingStore::writePages(const std::vector<PageWrite>& pages) {
+    if (pages.empty()) return 0;
+
+    std::lock_guard<std::mutex> lock(storeMutex);
+    ensureOpen();
+
+    std::vector<std::pair<uint32_t, const uint8_t*>> slots;
+    slots.reserve(pages.size());
+    for (const auto& page : pages)
+        slots.emplace_back(slotFor(page.pid, page.vpn), page.data);
+    sortForSweep(slots, headSlot);
+
+    size_t operations = 0;
+    std::vector<const uint8_t*> run;
+    uint32_t runStart = slots.front().first;
+    for (const auto& [slot, data] : slots) {
+        if (!run.empty() && slot == runStart + run.size() - 1) {
+            run.back() = data;     // Same slot again: the later copy wins
+            continue;
+        }
+        if (!run.empty() && slot != runStart + run.size()) {
+            writeSlotRun(runStart, run);
+            ++operations;
+            run.clear();
+        }
+        if (run.empty()) runStart = slot;
+        run.push_back(data);
+    }
+    writeSlotRun(runStart, run);
+    headSlot = slots.back().first;
+    return operations + 1;
+}
+
+// Reads a batch of pages, coalescing pages that sit in adjacent slots into one run
+size_t BackingStore::readPages(std::vector<PageRead>& pages) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    std::vector<std::pair<uint32_t, PageRead*>> slots;
+    slots.reserve(pages.size());
+    for (auto& page : pages) {
+        page.found = false;
+        auto procIt = slotIndex.find(page.pid);
+        if (procIt == slotIndex.end()) continue;
+        auto pageIt = procIt->second.find(page.vpn);
+        if (pageIt == procIt->second.end()) continue;
+        slots.emplace_back(pageIt->second, &page);
+        page.found = true;
+    }
+    if (slots.empty()) return 0;
+
+    ensureOpen();
+    sortForSweep(slots, headSlot);
+
+    size_t operations = 0;
+    std::vector<uint8_t*> run;
+    std::vector<std::pair<uint8_t*, const uint8_t*>> copies;    // Same slot asked for twice
+    uint32_t runStart = slots.front().first;
+    for (const auto& [slot, page] : slots) {
+        if (!run.empty() && slot == runStart + run.size() - 1) {
+            copies.emplace_back(page->dest, run.back());
+            continue;
+        }
+        if (!run.empty() && slot != runStart + run.size()) {
+            readSlotRun(runStart, run);
+            ++operations;
+            run.clear();
+        }
+        if (run.empty()) runStart = slot;
+        run.push_back(page->dest);
+    }
+    readSlotRun(runStart, run);
+    headSlot = slots.back().first;
+
+    for (const auto& [dest, src] : copies)
+        std::memcpy(dest, src, pageSize);
+    return operations + 1;
+}
+
+void BackingStore::writeSlotRun(uint32_t firstSlot, const std::vector<const uint8_t*>& pages) {
+    for (size_t i = 0; i < pages.size(); ++i)
+        writeSlot(firstSlot + static_cast<uint32_t>(i), pages[i]);
+}
+
+void BackingStore::readSlotRun(uint32_t firstSlot, const std::vector<uint8_t*>& pages) {
+    for (size_t i = 0; i < pages.size(); ++i)
+        readSlot(firstSlot + static_cast<uint32_t>(i), pages[i]);
+}
+
+bool BackingStore::contains(uint32_t pid, uint32_t vpn) const {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    auto procIt = slotIndex.find(pid);
+    return procIt != slotIndex.end() && procIt->second.count(vpn) > 0;
+}
+
+// Returns the slot of a single page to the free list
+void BackingStore::discardPage(uint32_t pid, uint32_t vpn) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    auto procIt = slotIndex.find(pid);
+    if (procIt == slotIndex.end()) return;
+
+    auto pageIt = procIt->second.find(vpn);
+    if (pageIt == procIt->second.end()) return;
+
+    freeSlots.push_back(pageIt->second);
+    procIt->second.erase(pageIt);
+    if (procIt->second.empty())
+        slotIndex.erase(procIt);
+}
+
+// Returns all slots of the process to the free list
+void BackingStore::releaseProcess(uint32_t pid) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    auto procIt = slotIndex.find(pid);
+    if (procIt == slotIndex.end()) return;
+
+    for (const auto& [vpn, slot] : procIt->second)
+        freeSlots.push_back(slot);
+    slotIndex.erase(procIt);
+}
+
+// Forgets every page; slots are reused from the start of the file
+void BackingStore::releaseAll() {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    slotIndex.clear();
+    freeSlots.clear();
+    for (uint32_t slot = slotCount; slot > 0; --slot)
+        freeSlots.push_back(slot - 1);
+}
+
+size_t BackingStore::getUsedSlots() const {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    return slotCount - freeSlots.size();
+}
+
+void BackingStore::flush() {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    if (fileOpen) flushFile();
+}
+
+void BackingStore::close() {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    if (!fileOpen) return;
+    closeFile();
+    fileOpen = false;
+}
+
+// Reopens a file closed by close() before its slots are touched (caller holds storeMutex)
+void BackingStore::ensureOpen() {
+    if (fileOpen) return;
+    openFile();
+    fileOpen = true;
+}
+
+// Returns the slot of a page, allocating one on its first write (caller holds storeMutex)
+uint32_t BackingStore::slotFor(uint32_t pid, uint32_t vpn) {
+    auto& pages = slotIndex[pid];
+    auto pageIt = pages.find(vpn);
+    if (pageIt != pages.end())
+        return pageIt->second;
+
+    uint32_t slot = allocateSlot();
+    pages.emplace(vpn, slot);
+    return slot;
+}
+
+// Reuses a released slot if possible, otherwise grows the store by one slot
+uint32_t BackingStore::allocateSlot() {
+    if (!freeSlots.empty()) {
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    reserveSlots(slotCount + 1);
+    return slotCount++;
+}
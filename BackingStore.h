@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct PageWrite
+ * @brief One page handed to BackingStore::writePages.
+ */
+struct PageWrite {
+    uint32_t pid;
+    uint32_t vpn;
+    const uint8_t* data;
+};
+
+/**
+ * @struct PageRead
+ * @brief One page handed to BackingStore::readPages.
+ */
+struct PageRead {
+    uint32_t pid;
+    uint32_t vpn;
+    uint8_t* dest;
+    bool found = false;     // Set when the page had a slot and dest now holds it
+};
+
+/**
+ * @class BackingStore
+ * @brief One fixed-slot swap file used by the MemoryManager for paging.
+ *
+ * The SwapDirectory gives every process a store of its own. Every page occupies exactly
+ * one slot of pageSize bytes. An in-memory index maps
+ * (pid, vpn) to its slot, so a page-in or page-out touches exactly one slot no matter
+ * how many pages are stored. Slots released by finished processes are recycled
+ * before the store grows.
+ *
+ * Subclasses decide how a slot is physically read and written:
+ * - FileBackingStore:   one seek + one pageSize read/write on a binary file.
+ * - MappedBackingStore: a memcpy into a memory-mapped file with preallocated slots.
+ */
+class BackingStore {
+public:
+    virtual ~BackingStore() = default;
+
+    /**
+     * @brief Creates the backing store implementation selected in config.txt.
+     * @param mode     "file" or "mmap".
+     * @param filename Path of the swap file.
+     * @param pageSize Size of one page/slot in bytes.
+     */
+    static std::unique_ptr<BackingStore> create(const std::string& mode, const std::string& filename, uint32_t pageSize);
+
+    /**
+     * @brief Copies a stored page into dest.
+     * @return false if the page was never written to the store.
+     */
+    bool readPage(uint32_t pid, uint32_t vpn, uint8_t* dest);
+
+    /**
+     * @brief Stores one page, allocating a slot for it on first write.
+     */
+    void writePage(uint32_t pid, uint32_t vpn, const uint8_t* src);
+
+    /**
+     * @brief Stores many pages at once. Pages are sorted by slot and every run of
+     *        contiguous slots is written with a single call to writeSlotRun.
+     * @return Number of I/Os issued.
+     */
+    size_t writePages(const std::vector<PageWrite>& pages);
+
+    /**
+     * @brief Reads many pages at once, setting found on each page that has a slot. Every run
+     *        of contiguous slots is read with a single call to readSlotRun.
+     * @return Number of I/Os issued.
+     */
+    size_t readPages(std::vector<PageRead>& pages);
+
+    /**
+     * @brief Checks if a page currently has a slot in the store.
+     */
+    bool contains(uint32_t pid, uint32_t vpn) const;
+
+    /**
+     * @brief Releases the slot of one page, if it has one.
+     */
+    void discardPage(uint32_t pid, uint32_t vpn);
+
+    /**
+     * @brief Releases every slot owned by the given process.
+     */
+    void releaseProcess(uint32_t pid);
+
+    /**
+     * @brief Releases every slot, e.g. before a checkpoint's pages are written back in.
+     */
+    void releaseAll();
+
+    /**
+     * @brief Returns the number of slots currently holding a page.
+     */
+    size_t getUsedSlots() const;
+
+    /**
+     * @brief Pushes buffered writes down to the underlying file.
+     */
+    void flush();
+
+    /**
+     * @brief Closes the underlying file but keeps every stored page; the next access reopens it.
+     */
+    void close();
+
+protected:
+    BackingStore(uint32_t pageSize) : pageSize(pageSize) {}
+
+    // Reopens the file closed by closeFile, keeping its contents
+    virtual void openFile() = 0;
+    virtual void closeFile() = 0;
+    virtual void flushFile() {}
+
+    /**
+     * @brief Makes sure slots [0, count) can be addressed. Called before a new slot is used.
+     */
+    virtual void reserveSlots(uint32_t /*count*/) {}
+
+    virtual void readSlot(uint32_t slot, uint8_t* dest) = 0;
+    virtual void writeSlot(uint32_t slot, const uint8_t* src) = 0;
+
+    /**
+     * @brief Writes pages into the contiguous slots [firstSlot, firstSlot + pages.size()).
+     *        The default writes them one slot at a time.
+     */
+    virtual void writeSlotRun(uint32_t firstSlot, const std::vector<const uint8_t*>& pages);
+
+    /**
+     * @brief Reads the contiguous slots [firstSlot, firstSlot + pages.size()) into pages.
+     *        The default reads them one slot at a time.
+     */
+    virtual void readSlotRun(uint32_t firstSlot, const std::vector<uint8_t*>& pages);
+
+    uint32_t pageSize;
+
+private:
+    uint32_t allocateSlot();
+    uint32_t slotFor(uint32_t pid, uint32_t vpn);
+    void ensureOpen();
+
+    bool fileOpen = true;                   // Subclass constructors open the file
+
+    uint32_t slotCount = 0;                 // Slots ever allocated
+    uint32_t headSlot = 0;                  // Last slot the previous batch touched
+    std::vector<uint32_t> freeSlots;        // Released slots available for reuse
+
+    // pid -> (vpn -> slot)
+    std::unordered_map<uint32_t, std::unordered_map<uint32_t, uint32_t>> slotIndex;
+
+    mutable std::mutex storeMutex;
+};
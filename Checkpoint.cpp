@@ -0,0 +1,360 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <stdexcept>
+
+#include "Checkpoint.h"
+#include "CheckpointStream.h"
+#include "Core.h"
+#include "GlobalScheduler.h"
+#include "Instruction.h"
+#include "MemoryManager.h"
+#include "Process.h"
+
+std::mutex Checkpoint::chainMutex;
+uint64_t Checkpoint::lastId = 0;
+std::string Checkpoint::lastPath;
+std::unordered_set<std::string> Checkpoint::chainFiles;
+std::unordered_map<int, Checkpoint::SavedProcess> Checkpoint::savedProcesses;
+
+// Identifies a checkpoint file so an incremental one can check it was given the right parent
+static uint64_t newCheckpointId() {
+    static std::mt19937_64 rng(std::random_device{}());
+    uint64_t id;
+    do {
+        id = rng();
+    } while (id == 0);
+    return id;
+}
+
+static std::optional<std::vector<uint8_t>> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return std::nullopt;
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+// Same file, however the path was spelled
+std::string Checkpoint::chainKey(const std::string& path) {
+    std::error_code error;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+    return error ? path : canonical.string();
+}
+
+CheckpointSummary Checkpoint::save(const std::string& path, bool incremental) {
+    std::lock_guard<std::mutex> chainLock(chainMutex);
+    if (incremental && lastId == 0)
+        throw std::runtime_error("No checkpoint to build on; take a full checkpoint first.");
+    if (incremental && chainFiles.count(chainKey(path)))
+        throw std::runtime_error("\"" + path + "\" is part of the chain this checkpoint builds on.");
+
+    auto scheduler = GlobalScheduler::getInstance();
+    auto memoryManager = MemoryManager::getInstance();
+
+    CheckpointWriter out;
+    CheckpointSummary summary;
+    uint64_t id = newCheckpointId();
+    std::unordered_map<int, SavedProcess> stored;
+
+    scheduler->pause();
+    auto pauseStart = std::chrono::steady_clock::now();
+    try {
+        // Every process the scheduler knows, plus any registered one it does not
+        std::vector<std::shared_ptr<Process>> processes = scheduler->getAllProcesses();
+        std::unordered_set<int> known;
+        for (const auto& process : processes)
+            known.insert(process->getPID());
+
+        std::vector<std::shared_ptr<Process>> registered = Process::getRegisteredProcesses();
+        std::unordered_set<int> registeredPids;
+        for (const auto& process : registered) {
+            registeredPids.insert(process->getPID());
+            if (known.insert(process->getPID()).second)
+                processes.push_back(process);
+        }
+
+        // An incremental checkpoint stores a process only if it changed since it was last stored,
+        // and leaves out what the chain already holds of a process it stores again
+        std::vector<const SavedProcess*> parentCopy;
+        std::vector<bool> written;
+        for (const auto& process : processes) {
+            uint64_t version = process->getVersion();
+            auto saved = incremental ? savedProcesses.find(process->getPID()) : savedProcesses.end();
+            parentCopy.push_back(saved != savedProcesses.end() ? &saved->second : nullptr);
+            written.push_back(!parentCopy.back() || parentCopy.back()->version != version);
+            stored[process->getPID()] = { version, parentCopy.back() ? parentCopy.back()->logEntries : 0 };
+        }
+
+        // Dispatch order on restore: processes on the cores first, then the ready queue
+        std::vector<uint32_t> readyOrder;
+        std::unordered_set<int> queued;
+        auto enqueue = [&](const std::shared_ptr<Process>& process) {
+            if (process && known.count(process->getPID()) && queued.insert(process->getPID()).second)
+                readyOrder.push_back(static_cast<uint32_t>(process->getPID()));
+        };
+        for (Core* core : scheduler->getCores())
+            enqueue(core->getCurrentProcess());
+        for (const auto& process : scheduler->getReadyQueue())
+            enqueue(process);
+
+        // Each distinct instruction object of a process stored with its instructions is written once
+        std::unordered_map<const Instruction*, uint32_t> instructionIds;
+        std::vector<const Instruction*> instructionTable;
+        for (size_t i = 0; i < processes.size(); ++i) {
+            if (!written[i] || parentCopy[i]) continue;
+            for (const auto& instr : processes[i]->getInstructions()) {
+                if (instructionIds.emplace(instr.get(), static_cast<uint32_t>(instructionTable.size())).second)
+                    instructionTable.push_back(instr.get());
+            }
+        }
+
+        out.write(MAGIC);
+        out.write(VERSION);
+        out.write(id);
+        out.write(incremental ? lastId : uint64_t{ 0 });
+        out.writeString(incremental ? lastPath : std::string());
+        out.write(static_cast<int32_t>(Process::peakNextPID()));
+        out.write(scheduler->getIdleTicks());
+        out.write(scheduler->getActiveTicks());
+        out.write(scheduler->getDeferredDispatches());
+
+        out.write(static_cast<uint32_t>(instructionTable.size()));
+        for (const Instruction* instr : instructionTable)
+            out.writeString(instr->toSource());
+
+        out.write(static_cast<uint32_t>(processes.size()));
+        for (size_t i = 0; i < processes.size(); ++i) {
+            out.write(static_cast<int32_t>(processes[i]->getPID()));
+            out.write(static_cast<bool>(registeredPids.count(processes[i]->getPID())));
+            out.write(static_cast<bool>(written[i]));
+            if (written[i]) {
+                SavedProcess& saved = stored[processes[i]->getPID()];
+                saved.logEntries = processes[i]->writeCheckpoint(out, instructionIds, !parentCopy[i], saved.logEntries);
+                ++summary.processesWritten;
+            }
+        }
+
+        out.write(static_cast<uint32_t>(readyOrder.size()));
+        for (uint32_t pid : readyOrder)
+            out.write(pid);
+
+        std::unordered_set<int> checkpointedPids;
+        if (incremental) {
+            for (const auto& [pid, saved] : savedProcesses)
+                checkpointedPids.insert(pid);
+        }
+        summary.framesWritten = memoryManager->writeCheckpoint(out, processes, incremental, checkpointedPids);
+        summary.processes = processes.size();
+    } catch (...) {
+        scheduler->resume();
+        throw;
+    }
+    scheduler->resume();
+    summary.pausedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pauseStart).count();
+
+    // The change marks are cleared now, so the chain goes on from this file or not at all
+    lastId = 0;
+
+    // Disk I/O happens after the cores are running again
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Cannot open \"" + path + "\" for writing.");
+    const std::vector<uint8_t>& data = out.getBuffer();
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file)
+        throw std::runtime_error("Failed to write \"" + path + "\".");
+
+    if (incremental) {
+        summary.parent = lastPath;
+    } else {
+        chainFiles.clear();
+    }
+    chainFiles.insert(chainKey(path));
+    lastId = id;
+    lastPath = path;
+    savedProcesses = std::move(stored);
+
+    summary.bytes = data.size();
+    return summary;
+}
+
+CheckpointSummary Checkpoint::restore(const std::string& path) {
+    std::lock_guard<std::mutex> chainLock(chainMutex);
+
+    auto scheduler = GlobalScheduler::getInstance();
+    auto memoryManager = MemoryManager::getInstance();
+    CheckpointSummary summary;
+    summary.bytes = 0;
+
+    // Reads the chain from the given file back to its full checkpoint
+    struct ChainFile {
+        std::string path;
+        uint64_t id;
+        CheckpointReader in;
+    };
+    std::vector<ChainFile> chain;
+    std::string filePath = path;
+    uint64_t expectedId = 0;
+    while (true) {
+        if (chain.size() == MAX_CHAIN_LENGTH)
+            throw std::runtime_error("The checkpoint chain of \"" + path + "\" is too long.");
+
+        std::optional<std::vector<uint8_t>> data = readFile(filePath);
+        if (!data && !chain.empty()) {
+            // The parent may have been moved along with the file that builds on it
+            std::string sibling = (std::filesystem::path(chain.back().path).parent_path() /
+                                   std::filesystem::path(filePath).filename()).string();
+            data = readFile(sibling);
+            if (data) filePath = sibling;
+        }
+        if (!data) {
+            if (chain.empty())
+                throw std::runtime_error("Cannot open \"" + filePath + "\".");
+            throw std::runtime_error("\"" + chain.back().path + "\" builds on \"" + filePath + "\", which cannot be opened.");
+        }
+
+        summary.bytes += data->size();
+        CheckpointReader in(std::move(*data));
+        if (in.read<uint32_t>() != MAGIC)
+            throw std::runtime_error("\"" + filePath + "\" is not a checkpoint file.");
+        uint32_t version = in.read<uint32_t>();
+        if (version != VERSION)
+            throw std::runtime_error("Checkpoint version " + std::to_string(version) + " is not supported.");
+
+        uint64_t id = in.read<uint64_t>();
+        if (expectedId != 0 && id != expectedId)
+            throw std::runtime_error("\"" + filePath + "\" is not the checkpoint \"" + chain.back().path + "\" builds on.");
+        uint64_t parentId = in.read<uint64_t>();
+        std::string parentPath = in.readString();
+
+        chain.push_back({ filePath, id, std::move(in) });
+        if (parentId == 0) break;
+        expectedId = parentId;
+        filePath = parentPath;
+    }
+
+    // Applies the files oldest first. A process a file does not store keeps its state (and page
+    // table) from the file before; one it stores is rebuilt and takes over the earlier page table
+    MemoryImage image;
+    std::vector<std::shared_ptr<Process>> processes;
+    std::vector<std::shared_ptr<Process>> registered;
+    std::vector<uint32_t> readyPids;
+    int32_t nextPID = 0;
+    uint64_t idleTicks = 0;
+    uint64_t activeTicks = 0;
+    uint64_t deferredDispatches = 0;
+
+    for (auto file = chain.rbegin(); file != chain.rend(); ++file) {
+        CheckpointReader& in = file->in;
+        nextPID = in.read<int32_t>();
+        idleTicks = in.read<uint64_t>();
+        activeTicks = in.read<uint64_t>();
+        deferredDispatches = in.read<uint64_t>();
+
+        std::vector<std::shared_ptr<Instruction>> instructionTable;
+        uint32_t instructionCount = in.readCount();
+        instructionTable.reserve(instructionCount);
+        for (uint32_t i = 0; i < instructionCount; ++i)
+            instructionTable.push_back(Instruction::fromString(in.readString()));
+
+        std::unordered_map<uint32_t, std::shared_ptr<Process>> previousByPid;
+        for (const auto& process : processes)
+            previousByPid[process->getPID()] = process;
+
+        std::vector<std::shared_ptr<Process>> fileProcesses;
+        std::vector<std::shared_ptr<Process>> fileRegistered;
+        std::unordered_map<uint32_t, std::shared_ptr<Process>> processByPid;
+        uint32_t processCount = in.readCount();
+        for (uint32_t i = 0; i < processCount; ++i) {
+            int32_t pid = in.read<int32_t>();
+            bool isRegistered = in.read<bool>();
+            auto previous = previousByPid.find(pid);
+
+            std::shared_ptr<Process> process;
+            if (in.read<bool>()) {
+                const Process* previousVersion = previous != previousByPid.end() ? previous->second.get() : nullptr;
+                process = Process::readCheckpoint(in, instructionTable, previousVersion);
+                if (process->getPID() != pid)
+                    throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+                if (previous != previousByPid.end())
+                    process->getPageTable() = std::move(previous->second->getPageTable());
+            } else {
+                if (previous == previousByPid.end())
+                    throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+                process = previous->second;
+            }
+
+            if (!processByPid.emplace(pid, process).second)
+                throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+            if (isRegistered)
+                fileRegistered.push_back(process);
+            fileProcesses.push_back(std::move(process));
+        }
+
+        readyPids.clear();
+        uint32_t readyCount = in.readCount(sizeof(uint32_t));
+        for (uint32_t i = 0; i < readyCount; ++i) {
+            uint32_t pid = in.read<uint32_t>();
+            if (!processByPid.count(pid))
+                throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+            readyPids.push_back(pid);
+        }
+
+        memoryManager->readCheckpoint(in, image, processByPid);
+        processes = std::move(fileProcesses);
+        registered = std::move(fileRegistered);
+    }
+
+    std::unordered_map<uint32_t, std::shared_ptr<Process>> processByPid;
+    for (const auto& process : processes) {
+        processByPid[process->getPID()] = process;
+        nextPID = std::max(nextPID, process->getPID() + 1);
+    }
+
+    std::vector<std::shared_ptr<Process>> ready;
+    for (uint32_t pid : readyPids) {
+        const auto& process = processByPid[pid];
+        if (process->getState() == ProcessState::Ready)
+            ready.push_back(process);
+    }
+
+    // A registered process that is Ready but was in neither queue (e.g. woken by the
+    // MemoryManager just before the checkpoint) still gets dispatched
+    for (const auto& process : registered) {
+        if (process->getState() == ProcessState::Ready && std::find(ready.begin(), ready.end(), process) == ready.end())
+            ready.push_back(process);
+    }
+
+    scheduler->pause();
+    auto pauseStart = std::chrono::steady_clock::now();
+    try {
+        // Swaps in the new memory and registry
+        memoryManager->restoreCheckpoint(image, processes, registered);
+    } catch (...) {
+        scheduler->resume();
+        throw;
+    }
+    scheduler->replaceProcesses(processes, std::move(ready));
+    scheduler->restoreTickCounters(idleTicks, activeTicks, deferredDispatches);
+    Process::restoreNextPID(nextPID);
+    scheduler->resume();
+    summary.pausedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pauseStart).count();
+
+    // The next incremental checkpoint builds on the file that was restored
+    lastId = chain.front().id;
+    lastPath = path;
+    chainFiles.clear();
+    for (const ChainFile& file : chain)
+        chainFiles.insert(chainKey(file.path));
+    savedProcesses.clear();
+    for (const auto& process : processes)
+        savedProcesses[process->getPID()] = { process->getVersion(), process->getLogs().size() };
+
+    summary.processes = processes.size();
+    summary.processesWritten = processes.size();
+    summary.files = chain.size();
+    return summary;
+}
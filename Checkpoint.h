@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @struct CheckpointSummary
+ * @brief What a checkpoint held and how long the operation kept the cores paused.
+ */
+struct CheckpointSummary {
+    size_t processes = 0;
+    size_t processesWritten = 0;    // Processes stored in the file; fewer than processes if incremental
+    uint32_t framesWritten = 0;     // Frames whose contents are stored in the file
+    uint64_t bytes = 0;
+    size_t files = 1;               // Files read by a restore: the chain back to a full checkpoint
+    std::string parent;             // File an incremental checkpoint builds on
+    double pausedMs = 0.0;
+};
+
+/**
+ * @class Checkpoint
+ * @brief Saves the whole emulator to a binary file and brings it back.
+ *
+ * A checkpoint holds physical memory and the frame table, shared-memory segments, every
+ * process (page table, instruction pointer, variables, logs), the contents of pages that
+ * were paged out, the memory wait queue, the ready queue and the CPU tick counters.
+ * Instructions shared between processes (e.g. by clones) are stored once.
+ *
+ * An incremental checkpoint builds on the last checkpoint taken or restored: it stores only
+ * the processes whose version changed, the frames whose contents changed and the page table
+ * entries whose mapping changed since then, plus the small tables (frames, segments, queues)
+ * in full. Restoring it reads the chain back to its full checkpoint and applies each file in turn.
+ *
+ * Saving pauses the scheduler at a tick boundary and waits for every core to finish its
+ * current instruction, so the copy is consistent; the file is written after the cores resume.
+ * Restoring reads and checks every file of the chain before replacing anything. Processes that
+ * were running come back Ready at the front of the ready queue. The system must have been
+ * initialized with the same memory and frame sizes as the one that took the checkpoint.
+ */
+class Checkpoint {
+public:
+    /**
+     * @brief Writes a checkpoint of the running system.
+     * @param incremental Store only what changed since the last checkpoint.
+     * @throws std::runtime_error If the file cannot be written, or an incremental checkpoint
+     *         has nothing to build on.
+     */
+    static CheckpointSummary save(const std::string& path, bool incremental);
+
+    /**
+     * @brief Replaces the running system's processes and memory with a checkpoint.
+     * @throws std::runtime_error If a file of the chain cannot be read or does not fit this
+     *         system; the running system is left as it was.
+     */
+    static CheckpointSummary restore(const std::string& path);
+
+private:
+    static constexpr uint32_t MAGIC = 0x4B435343;   // "CSCK"
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t MAX_CHAIN_LENGTH = 1024;
+
+    static std::string chainKey(const std::string& path);
+
+    struct SavedProcess {
+        uint64_t version;           // Process::getVersion() when it was stored
+        size_t logEntries;          // Log entries the chain holds
+    };
+
+    // The checkpoint the next incremental one builds on (id 0: none yet, or the last save failed)
+    static std::mutex chainMutex;
+    static uint64_t lastId;
+    static std::string lastPath;
+    static std::unordered_set<std::string> chainFiles;          // Files the last checkpoint depends on
+    static std::unordered_map<int, SavedProcess> savedProcesses;
+};
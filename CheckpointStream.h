@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class CheckpointWriter
+ * @brief Appends fixed-size values, strings and raw bytes to an in-memory checkpoint buffer.
+ *
+ * Values are stored in host byte order, so a checkpoint is only meant to be restored
+ * on the same kind of machine that wrote it.
+ */
+class CheckpointWriter {
+public:
+    template <typename T>
+    void write(T value) {
+        static_assert(std::is_trivially_copyable_v<T>, "only fixed-size values can be written directly");
+        writeBytes(&value, sizeof(T));
+    }
+
+    // Length-prefixed string
+    void writeString(const std::string& value) {
+        write(static_cast<uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+    void writeBytes(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    const std::vector<uint8_t>& getBuffer() const { return buffer; }
+
+private:
+    std::vector<uint8_t> buffer;
+};
+
+/**
+ * @class CheckpointReader
+ * @brief Reads back what a CheckpointWriter wrote. Throws std::runtime_error when the
+ *        data ends early, so a truncated file never yields half-restored state.
+ */
+class CheckpointReader {
+public:
+    explicit CheckpointReader(std::vector<uint8_t> data) : buffer(std::move(data)) {}
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "only fixed-size values can be read directly");
+        T value;
+        readBytes(&value, sizeof(T));
+        return value;
+    }
+
+    std::string readString() {
+        uint32_t size = read<uint32_t>();
+        require(size);
+        std::string value(reinterpret_cast<const char*>(buffer.data() + offset), size);
+        offset += size;
+        return value;
+    }
+
+    void readBytes(void* dest, size_t size) {
+        require(size);
+        std::memcpy(dest, buffer.data() + offset, size);
+        offset += size;
+    }
+
+    // Element count of a list that follows; rejects counts the remaining data cannot hold
+    uint32_t readCount(size_t minElementSize = 1) {
+        uint32_t count = read<uint32_t>();
+        require(static_cast<size_t>(count) * minElementSize);
+        return count;
+    }
+
+private:
+    void require(size_t size) const {
+        if (size > buffer.size() - offset)
+            throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+    }
+
+    std::vector<uint8_t> buffer;
+    size_t offset = 0;
+};
@@ -0,0 +1,46 @@
+#include "ClockPolicy.h"
+
+ClockPolicy::ClockPolicy(uint32_t totalFrames)
+    : tracked(totalFrames, false) {
+}
+
+void ClockPolicy::onPageLoaded(uint32_t frameNumber) {
+    if (!tracked[frameNumber]) ++trackedCount;
+    tracked[frameNumber] = true;
+}
+
+void ClockPolicy::onFrameFreed(uint32_t frameNumber) {
+    if (tracked[frameNumber]) --trackedCount;
+    tracked[frameNumber] = false;
+}
+
+void ClockPolicy::onFrameMoved(uint32_t from, uint32_t to) {
+    if (!tracked[from]) return;
+    tracked[from] = false;
+    tracked[to] = true;
+}
+
+// Advances the hand, clearing referenced bits, until an unreferenced frame is found
+std::optional<uint32_t> ClockPolicy::selectVictim(const ReferenceProbe& testAndClearReferenced) {
+    if (trackedCount == 0) return std::nullopt;
+
+    while (true) {
+        uint32_t frame = static_cast<uint32_t>(hand);
+        hand = (hand + 1) % tracked.size();
+
+        if (!tracked[frame]) continue;
+        if (testAndClearReferenced(frame)) continue;
+
+        onFrameFreed(frame);
+        return frame;
+    }
+}
+
+std::vector<uint32_t> ClockPolicy::peekVictims(size_t count) const {
+    std::vector<uint32_t> victims;
+    for (size_t i = 0; i < tracked.size() && victims.size() < count; ++i) {
+        size_t frame = (hand + i) % tracked.size();
+        if (tracked[frame]) victims.push_back(static_cast<uint32_t>(frame));
+    }
+    return victims;
+}
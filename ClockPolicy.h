@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+#include "PageReplacementPolicy.h"
+
+/**
+ * @class ClockPolicy
+ * @brief Second-chance replacement implemented as a hand sweeping circularly over the frame table.
+ */
+class ClockPolicy : public PageReplacementPolicy {
+public:
+    ClockPolicy(uint32_t totalFrames);
+
+    void onPageLoaded(uint32_t frameNumber) override;
+    void onFrameFreed(uint32_t frameNumber) override;
+    void onFrameMoved(uint32_t from, uint32_t to) override;
+    std::optional<uint32_t> selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+    std::vector<uint32_t> peekVictims(size_t count) const override;
+    std::string getName() const override { return "clock"; }
+
+private:
+    std::vector<bool> tracked;      // Frames currently holding a page
+    size_t trackedCount = 0;
+    size_t hand = 0;                // Next frame to inspect
+};
@@ -0,0 +1,200 @@
+#include "CompressedPageCache.h"
+
+namespace {
+    // Token byte: two type bits followed by (run length - 1) in the low six bits
+    constexpr uint8_t TOKEN_ZERO_RUN = 0x00;    // Run of zero words, no payload
+    constexpr uint8_t TOKEN_SMALL = 0x40;       // Words below 256, one payload byte each
+    constexpr uint8_t TOKEN_WIDE = 0x80;        // Any words, two payload bytes each (little-endian)
+    constexpr uint8_t TOKEN_TYPE_MASK = 0xC0;
+    constexpr uint32_t MAX_RUN = 64;
+
+    enum class WordKind { Zero, Small, Wide };
+
+    WordKind kindOf(uint16_t word) {
+        if (word == 0) return WordKind::Zero;
+        return word < 256 ? WordKind::Small : WordKind::Wide;
+    }
+
+    uint16_t wordAt(const uint8_t* page, uint32_t index) {
+        return static_cast<uint16_t>(page[index * 2]) | (static_cast<uint16_t>(page[index * 2 + 1]) << 8);
+    }
+}
+
+CompressedPageCache::CompressedPageCache(uint32_t pageSize, size_t capacityBytes)
+    : pageSize(pageSize), capacityBytes(capacityBytes) {
+}
+
+// Encodes a page as zero/small/wide word runs; an odd trailing byte is appended raw
+std::vector<uint8_t> CompressedPageCache::compress(const uint8_t* page) const {
+    std::vector<uint8_t> out;
+    const uint32_t words = pageSize / 2;
+
+    uint32_t i = 0;
+    while (i < words) {
+        WordKind kind = kindOf(wordAt(page, i));
+        uint32_t run = 1;
+        while (i + run < words && run < MAX_RUN && kindOf(wordAt(page, i + run)) == kind)
+            ++run;
+
+        uint8_t type = kind == WordKind::Zero ? TOKEN_ZERO_RUN : kind == WordKind::Small ? TOKEN_SMALL : TOKEN_WIDE;
+        out.push_back(static_cast<uint8_t>(type | (run - 1)));
+
+        for (uint32_t j = i; j < i + run; ++j) {
+            if (kind == WordKind::Small) {
+                out.push_back(page[j * 2]);
+            } else if (kind == WordKind::Wide) {
+                out.push_back(page[j * 2]);
+                out.push_back(page[j * 2 + 1]);
+            }
+        }
+        i += run;
+    }
+
+    if (pageSize % 2 != 0)
+        out.push_back(page[pageSize - 1]);
+    return out;
+}
+
+void CompressedPageCache::decompress(const std::vector<uint8_t>& data, uint8_t* dest) const {
+    const uint32_t words = pageSize / 2;
+    size_t pos = 0;
+    uint32_t word = 0;
+
+    while (word < words) {
+        uint8_t token = data[pos++];
+        uint32_t run = (token & ~TOKEN_TYPE_MASK) + 1;
+        uint8_t type = token & TOKEN_TYPE_MASK;
+
+        for (uint32_t j = 0; j < run; ++j, ++word) {
+            if (type == TOKEN_ZERO_RUN) {
+                dest[word * 2] = 0;
+                dest[word * 2 + 1] = 0;
+            } else if (type == TOKEN_SMALL) {
+                dest[word * 2] = data[pos++];
+                dest[word * 2 + 1] = 0;
+            } else {
+                dest[word * 2] = data[pos++];
+                dest[word * 2 + 1] = data[pos++];
+            }
+        }
+    }
+
+    if (pageSize % 2 != 0)
+        dest[pageSize - 1] = data[pos];
+}
+
+bool CompressedPageCache::store(uint32_t pid, uint32_t vpn, const uint8_t* page, std::vector<EvictedPage>& evicted) {
+    if (!isEnabled()) return false;
+
+    std::vector<uint8_t> compressed = compress(page);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    erase(pid, vpn);
+
+    // Only keep pages that shrink by at least a quarter and fit in the pool at all
+    if (compressed.size() > pageSize * 3 / 4 || compressed.size() > capacityBytes)
+        return false;
+
+    // Push the oldest pages out until the new one fits
+    while (usedBytes + compressed.size() > capacityBytes && !ageOrder.empty()) {
+        auto [oldPid, oldVpn] = ageOrder.front();
+        EvictedPage out{ oldPid, oldVpn, std::vector<uint8_t>(pageSize) };
+        decompress(entries[oldPid][oldVpn].data, out.data.data());
+        evicted.push_back(std::move(out));
+        erase(oldPid, oldVpn);
+    }
+
+    originalBytesStored += pageSize;
+    compressedBytesStored += compressed.size();
+    usedBytes += compressed.size();
+
+    ageOrder.emplace_back(pid, vpn);
+    entries[pid][vpn] = { std::move(compressed), std::prev(ageOrder.end()) };
+    return true;
+}
+
+bool CompressedPageCache::load(uint32_t pid, uint32_t vpn, uint8_t* dest) {
+    if (!isEnabled()) return false;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto procIt = entries.find(pid);
+    if (procIt == entries.end() || procIt->second.find(vpn) == procIt->second.end()) {
+        ++misses;
+        return false;
+    }
+
+    decompress(procIt->second[vpn].data, dest);
+    erase(pid, vpn);
+    ++hits;
+    return true;
+}
+
+bool CompressedPageCache::peek(uint32_t pid, uint32_t vpn, uint8_t* dest) const {
+    if (!isEnabled()) return false;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto procIt = entries.find(pid);
+    if (procIt == entries.end()) return false;
+
+    auto pageIt = procIt->second.find(vpn);
+    if (pageIt == procIt->second.end()) return false;
+
+    decompress(pageIt->second.data, dest);
+    return true;
+}
+
+void CompressedPageCache::invalidate(uint32_t pid, uint32_t vpn) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    erase(pid, vpn);
+}
+
+void CompressedPageCache::releaseProcess(uint32_t pid) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto procIt = entries.find(pid);
+    if (procIt == entries.end()) return;
+
+    for (auto& [vpn, entry] : procIt->second) {
+        usedBytes -= entry.data.size();
+        ageOrder.erase(entry.age);
+    }
+    entries.erase(procIt);
+}
+
+void CompressedPageCache::clear() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    entries.clear();
+    ageOrder.clear();
+    usedBytes = 0;
+}
+
+// Removes one page if present (caller holds cacheMutex)
+void CompressedPageCache::erase(uint32_t pid, uint32_t vpn) {
+    auto procIt = entries.find(pid);
+    if (procIt == entries.end()) return;
+
+    auto pageIt = procIt->second.find(vpn);
+    if (pageIt == procIt->second.end()) return;
+
+    usedBytes -= pageIt->second.data.size();
+    ageOrder.erase(pageIt->second.age);
+    procIt->second.erase(pageIt);
+    if (procIt->second.empty())
+        entries.erase(procIt);
+}
+
+size_t CompressedPageCache::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return usedBytes;
+}
+
+size_t CompressedPageCache::getStoredPages() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return ageOrder.size();
+}
+
+// Original size over compressed size of every page the pool accepted
+double CompressedPageCache::getCompressionRatio() const {
+    uint64_t compressed = compressedBytesStored;
+    return compressed == 0 ? 0.0 : static_cast<double>(originalBytesStored) / compressed;
+}
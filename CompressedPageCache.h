@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct EvictedPage
+ * @brief Page pushed out of the compressed pool, to be written to the backing store by the caller.
+ */
+struct EvictedPage {
+    uint32_t pid;
+    uint32_t vpn;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @class CompressedPageCache
+ * @brief Bounded in-RAM pool of compressed pages that sits in front of the backing store.
+ *
+ * Evicted dirty pages are compressed into the pool instead of being written out, and a
+ * page fault that finds its page here is served without any disk I/O. Pages are encoded
+ * as runs of 16-bit words: zero runs take one byte, small (< 256) values one byte each and
+ * other values two bytes each, which suits memory filled by the emulator's uint16 variables.
+ * Pages that would not shrink by at least a quarter are rejected. When the pool is full the
+ * oldest pages are handed back to the caller to be written to the backing store.
+ *
+ * A page is held by the pool or by its frame, never both: load() removes the page.
+ */
+class CompressedPageCache {
+public:
+    /**
+     * @param pageSize      Size of one page in bytes.
+     * @param capacityBytes Bytes of compressed data the pool may hold; 0 disables the pool.
+     */
+    CompressedPageCache(uint32_t pageSize, size_t capacityBytes);
+
+    /**
+     * @brief Compresses a page into the pool, replacing any older copy.
+     * @param evicted Receives the pages pushed out to make room.
+     * @return false if the pool is disabled or the page does not compress well enough.
+     */
+    bool store(uint32_t pid, uint32_t vpn, const uint8_t* page, std::vector<EvictedPage>& evicted);
+
+    /**
+     * @brief Decompresses a page into dest and removes it from the pool.
+     * @return false if the page is not in the pool.
+     */
+    bool load(uint32_t pid, uint32_t vpn, uint8_t* dest);
+
+    /**
+     * @brief Decompresses a page into dest and leaves it in the pool. Not counted as a hit or miss.
+     * @return false if the page is not in the pool.
+     */
+    bool peek(uint32_t pid, uint32_t vpn, uint8_t* dest) const;
+
+    /**
+     * @brief Drops one page from the pool, if present.
+     */
+    void invalidate(uint32_t pid, uint32_t vpn);
+
+    /**
+     * @brief Drops every page of a process.
+     */
+    void releaseProcess(uint32_t pid);
+
+    /**
+     * @brief Drops every page in the pool.
+     */
+    void clear();
+
+    bool isEnabled() const { return capacityBytes > 0; }
+    size_t getCapacityBytes() const { return capacityBytes; }
+    size_t getUsedBytes() const;
+    size_t getStoredPages() const;
+    double getCompressionRatio() const;
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+
+private:
+    struct Entry {
+        std::vector<uint8_t> data;
+        std::list<std::pair<uint32_t, uint32_t>>::iterator age;
+    };
+
+    std::vector<uint8_t> compress(const uint8_t* page) const;
+    void decompress(const std::vector<uint8_t>& data, uint8_t* dest) const;
+    void erase(uint32_t pid, uint32_t vpn);
+
+    uint32_t pageSize;
+    size_t capacityBytes;
+    size_t usedBytes = 0;
+
+    // pid -> (vpn -> compressed page)
+    std::unordered_map<uint32_t, std::unordered_map<uint32_t, Entry>> entries;
+    std::list<std::pair<uint32_t, uint32_t>> ageOrder;     // (pid, vpn), oldest first
+
+    std::atomic<uint64_t> hits = 0;
+    std::atomic<uint64_t> misses = 0;
+    std::atomic<uint64_t> originalBytesStored = 0;          // Uncompressed size of every accepted page
+    std::atomic<uint64_t> compressedBytesStored = 0;        // Compressed size of every accepted page
+
+    mutable std::mutex cacheMutex;
+};
@@ -1,6 +1,7 @@
 #include "Core.h"
 #include "Process.h"
 #include "GlobalScheduler.h"
+#include "MemoryManager.h"
 
 // Constructor: initializes core with given id
 Core::Core(int id) : cid(id) {}
@@ -13,6 +14,8 @@ Core::~Core() {
 // Starts the worker thread for this core
 void Core::start() {
     running = true;
+    if (auto memoryManager = MemoryManager::getInstance())
+        memoryManager->registerTLB(cid, &tlb);
     workerThread = std::thread(&Core::run, this);
 }
 
@@ -20,8 +23,12 @@ void Core::start() {
 void Core::stop() {
     running = false;
     cv.notify_one();                // Wake thread to exit if waiting
-    if (workerThread.joinable())
+    if (workerThread.joinable()) {
         workerThread.join();        // Wait for thread to finish
+
+        if (auto memoryManager = MemoryManager::getInstance())
+            memoryManager->unregisterTLB(cid);
+    }
 }
 
 // Assigns a process to this core with a delay per execution
@@ -46,7 +53,9 @@ std::shared_ptr<Process> Core::getCurrentProcess() const {
 std::shared_ptr<Process> Core::preemptProcess() {
     std::lock_guard<std::mutex> lock(mtx);
     if (currentProcess && !currentProcess->isFinished()) {
-        currentProcess->setState(ProcessState::Ready);
+        // A process blocked on memory stays blocked; the MemoryManager wakes it
+        if (currentProcess->getState() != ProcessState::Blocked)
+            currentProcess->setState(ProcessState::Ready);
         currentProcess->setCoreID(-1);
         auto p = currentProcess;
         currentProcess.reset();
@@ -66,6 +75,36 @@ void Core::clearProcess() {
     runTicks = 0;
 }
 
+// Detaches the current process if it is blocked on memory and returns it
+std::shared_ptr<Process> Core::releaseBlockedProcess() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!currentProcess || currentProcess->getState() != ProcessState::Blocked)
+        return nullptr;
+
+    auto p = currentProcess;
+    p->setCoreID(-1);
+    currentProcess.reset();
+    free = true;
+    runTicks = 0;
+    return p;
+}
+
+// Holding the core's lock means no instruction is executing, since run() keeps it for the
+// whole instruction; with paused set, pending ticks wait until resume()
+void Core::pause() {
+    std::lock_guard<std::mutex> lock(mtx);
+    paused = true;
+}
+
+// Lets the core act on ticks again
+void Core::resume() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        paused = false;
+    }
+    cv.notify_one();
+}
+
 // Checks if the core is free (not running a process)
 bool Core::isFree() const {
     return free;
@@ -88,13 +127,18 @@ void Core::resetRunTime() {
     runTicks = 0;
 }
 
+// Returns this core's translation lookaside buffer
+TLB& Core::getTLB() {
+    return tlb;
+}
+
 // Main worker thread loop for the core
 void Core::run() {
     while (true) {
         std::unique_lock<std::mutex> lock(mtx);
-        // Wait until either the core is stopped or a tick is ready
+        // Wait until either the core is stopped or a tick is ready and the core is not paused
         cv.wait(lock, [&]() { 
-            return !running || tickReady; 
+            return !running || (tickReady && !paused); 
         });
 
         if (!running) break; // Exit if core is stopped
@@ -102,6 +146,10 @@ void Core::run() {
         tickReady = false; 
         auto proc = currentProcess;
 
+        // Nothing to run, the process is waiting for memory until the scheduler releases it,
+        // or it was terminated and waits for the scheduler to free it
+        if (!proc || proc->getState() == ProcessState::Blocked || proc->isTerminated()) continue;
+
         proc->executeInstruction(delayPerExec); // Execute one instruction
 
         if (proc->isTerminated()) { // If process is terminated, clean up
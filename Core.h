@@ -7,6 +7,8 @@
 #include <thread>
 #include <chrono>
 
+#include "TLB.h"
+
 class Process;
 
 class GlobalScheduler; // Forward declaration for GlobalScheduler
@@ -92,6 +94,34 @@ public:
 
 
 
+    /**
+     * @brief Detach the current process if it is blocked waiting for memory.
+     *
+     * The check and the release happen under the core's lock, so a process
+     * that is mid-instruction is never detached.
+     *
+     * @return Shared pointer to the released Process, or nullptr if none.
+     */
+    std::shared_ptr<Process> releaseBlockedProcess();
+
+
+
+    /**
+     * @brief Wait for the instruction in flight, if any, and execute no more until resume().
+     *
+     * Used to take a consistent checkpoint while processes are assigned to the core.
+     */
+    void pause();
+
+
+
+    /**
+     * @brief Let the core execute instructions again after pause().
+     */
+    void resume();
+
+
+
     /**
      * @brief Check if the core is available for process assignment.
      *
@@ -124,6 +154,15 @@ public:
      */
     void resetRunTime();
 
+
+
+    /**
+     * @brief Get this core's translation lookaside buffer.
+     *
+     * @return Reference to the TLB used for processes running on this core.
+     */
+    TLB& getTLB();
+
 	void tick();
 
 private:
@@ -147,7 +186,10 @@ private:
     int runTicks = 0;                       // Count of executed instruction ticks
 
 	bool tickReady = false;          // True if ready to execute next instruction
+    bool paused = false;                    // Set by pause(); ticks wait until resume()
 
     std::shared_ptr<Process> currentProcess = nullptr;  // currently assigned process.
 
+    TLB tlb;                                // Translation cache for this core, registered with the MemoryManager while running
+
 };
\ No newline at end of file
@@ -18,4 +18,8 @@ int DeclareInstruction::execute(Process& process) {
 
 std::string DeclareInstruction::toString() const {
     return "DECLARE " + var + " = " + std::to_string(value);
+}
+
+std::string DeclareInstruction::toSource() const {
+    return "DECLARE " + var + " " + std::to_string(value);
 }
\ No newline at end of file
@@ -46,6 +46,16 @@ public:
      */
     std::string toString() const override;
 
+
+
+
+    /**
+     * @brief Returns the instruction in the syntax Instruction::fromString parses.
+     *
+     * @return std::string "DECLARE <var> <value>".
+     */
+    std::string toSource() const override;
+
 private:
 	std::string var;    // name of the variable to declare
 	uint16_t value;     // immediate value to assign to the variable
@@ -49,6 +49,15 @@ void FCFSScheduler::addProcess(std::shared_ptr<Process> process) {
     }
 }
 
+// Re-adds a process that is already tracked in allProcesses, such as one woken after waiting for memory
+void FCFSScheduler::requeueProcess(std::shared_ptr<Process> process) {
+    {
+        std::lock_guard<std::mutex> lock(readyQueueMutex);
+        readyQueue.push_back(process);
+    }
+    cvReadyQueue.notify_one();
+}
+
 void FCFSScheduler::schedulerLoop() {
     while (!shutdownFlag) {
         {
@@ -63,18 +72,31 @@ void FCFSScheduler::schedulerLoop() {
 
         if (shutdownFlag) break;
 
+        // A checkpoint holds this while it pauses the cores and copies the system
+        std::lock_guard<std::mutex> tickLock(tickMutex);
+
+        // One working-set sample per scheduler tick, then compaction if memory is fragmented
+        MemoryManager::getInstance()->sampleWorkingSets();
+        MemoryManager::getInstance()->compactIfFragmented();
+
         for (auto& core : cores) {
             auto process = core->getCurrentProcess();
 
             if (process) {
-                if (process->getRemainingInstruction() == 0) {
+                if (process->getRemainingInstruction() == 0 || process->isTerminated()) {
                     core->clearProcess();
-                    process->setState(ProcessState::Finished);
+                    if (!process->isTerminated())
+                        process->setState(ProcessState::Finished);
 
+                    // Finished or terminated, its frames and swap file are released before it is unregistered
                     MemoryManager::getInstance()->freeProcessPages(process->getPID());
 
                     Process::unregisterProcess(process->getPID());
                 }
+                else {
+                    // Blocked on memory: free the core, the MemoryManager requeues it once a frame is freed
+                    core->releaseBlockedProcess();
+                }
             }
         }
 
@@ -88,12 +110,24 @@ void FCFSScheduler::schedulerLoop() {
                 for (auto it = readyQueue.begin(); it != readyQueue.end(); ) {
                     auto proc = *it;
                     
-                    if (proc->getState() == ProcessState::Blocked || proc->isTerminated()) {
+                    // Drop stale entries: blocked, terminated, or already running on a core
+                    if (proc->getState() == ProcessState::Blocked || proc->isTerminated() || proc->getCoreID() != -1) {
                         it = readyQueue.erase(it);
                         continue;
                     }
 
                     if (proc->getState() == ProcessState::Ready) {
+                        // Leave it queued while its working set cannot fit; it would only fault and block.
+                        // After MAX_DISPATCH_DEFERRALS attempts it is dispatched anyway so it cannot starve
+                        if (proc->getDispatchDeferrals() < MAX_DISPATCH_DEFERRALS &&
+                            !MemoryManager::getInstance()->workingSetFits(*proc)) {
+                            proc->setDispatchDeferrals(proc->getDispatchDeferrals() + 1);
+                            GlobalScheduler::getInstance()->incrementDeferredDispatches();
+                            ++it;
+                            continue;
+                        }
+
+                        proc->setDispatchDeferrals(0);
                         nextProcess = proc;
                         it = readyQueue.erase(it);
                         break;
@@ -143,6 +177,43 @@ bool FCFSScheduler::noProcessFinished() {
     return true;
 }
 
+// Stops scheduling at a tick boundary, then waits for every core to finish its instruction
+void FCFSScheduler::pause() {
+    pauseLock = std::unique_lock<std::mutex>(tickMutex);
+    for (auto& core : cores)
+        core->pause();
+}
+
+void FCFSScheduler::resume() {
+    for (auto& core : cores)
+        core->resume();
+    pauseLock.unlock();
+}
+
+std::vector<std::shared_ptr<Process>> FCFSScheduler::getReadyQueue() const {
+    std::lock_guard<std::mutex> lock(readyQueueMutex);
+    return readyQueue;
+}
+
+// Swaps in the processes of a restored checkpoint (scheduler paused). Cores are emptied and
+// the ready processes are dispatched from the next tick on
+void FCFSScheduler::replaceProcesses(std::vector<std::shared_ptr<Process>> processes, std::vector<std::shared_ptr<Process>> ready) {
+    for (auto& core : cores) {
+        if (core->getCurrentProcess())
+            core->clearProcess();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(allProcessesMutex);
+        allProcesses = std::move(processes);
+    }
+    {
+        std::lock_guard<std::mutex> lock(readyQueueMutex);
+        readyQueue = std::move(ready);
+    }
+    cvReadyQueue.notify_one();
+}
+
 std::vector<Core*> FCFSScheduler::getCores() const {
     std::vector<Core*> list;
     list.reserve(cores.size());
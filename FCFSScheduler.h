@@ -23,6 +23,7 @@ public:
     void stop() override;
 
     void addProcess(std::shared_ptr<Process> process) override;
+    void requeueProcess(std::shared_ptr<Process> process) override;
     std::vector<std::shared_ptr<Process>> getAllProcesses() const override;
 
     bool allCoresFree() override;
@@ -30,6 +31,11 @@ public:
 
     std::vector<Core*> getCores() const override;
 
+    void pause() override;
+    void resume() override;
+    std::vector<std::shared_ptr<Process>> getReadyQueue() const override;
+    void replaceProcesses(std::vector<std::shared_ptr<Process>> processes, std::vector<std::shared_ptr<Process>> ready) override;
+
 private:
     void schedulerLoop();
 
@@ -44,6 +50,9 @@ private:
     mutable std::mutex readyQueueMutex;
     std::condition_variable cvReadyQueue;
 
+    std::mutex tickMutex;                       // Held for each scheduler tick
+    std::unique_lock<std::mutex> pauseLock;     // Holds tickMutex between pause() and resume()
+
     int numCores;
     unsigned long delaysPerExec;
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include <algorithm>
+
+#include "FIFOPolicy.h"
+
+void FIFOPolicy::onPageLoaded(uint32_t frameNumber) {
+    queue.push_back(frameNumber);
+}
+
+void FIFOPolicy::onFrameFreed(uint32_t frameNumber) {
+    queue.erase(std::remove(queue.begin(), queue.end(), frameNumber), queue.end());
+}
+
+void FIFOPolicy::onFrameMoved(uint32_t from, uint32_t to) {
+    std::replace(queue.begin(), queue.end(), from, to);
+}
+
+// The oldest frame is always the victim, referenced bits are ignored
+std::optional<uint32_t> FIFOPolicy::selectVictim(const ReferenceProbe& /*testAndClearReferenced*/) {
+    if (queue.empty()) return std::nullopt;
+
+    uint32_t victim = queue.front();
+    queue.pop_front();
+    return victim;
+}
+
+std::vector<uint32_t> FIFOPolicy::peekVictims(size_t count) const {
+    count = std::min(count, queue.size());
+    return std::vector<uint32_t>(queue.begin(), queue.begin() + count);
+}
@@ -0,0 +1,62 @@
+#include "FileBackingStore.h"
+
+#include <cstring>
+#include <stdexcept>
+
+// Opens the swap file, discarding any contents from a previous run
+FileBackingStore::FileBackingStore(const std::string& filename, uint32_t pageSize)
+    : BackingStore(pageSize), filename(filename) {
+    file.open(filename, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        throw std::runtime_error("Failed to open backing store \"" + filename + "\"");
+}
+
+// One seek + one pageSize read
+void FileBackingStore::readSlot(uint32_t slot, uint8_t* dest) {
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(slot) * pageSize);
+    file.read(reinterpret_cast<char*>(dest), pageSize);
+}
+
+// One seek + one pageSize write
+void FileBackingStore::writeSlot(uint32_t slot, const uint8_t* src) {
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(slot) * pageSize);
+    file.write(reinterpret_cast<const char*>(src), pageSize);
+    file.flush();
+}
+
+// One seek + one write for a whole run of adjacent slots
+void FileBackingStore::writeSlotRun(uint32_t firstSlot, const std::vector<const uint8_t*>& pages) {
+    std::vector<char> buffer(pages.size() * pageSize);
+    for (size_t i = 0; i < pages.size(); ++i)
+        std::memcpy(buffer.data() + i * pageSize, pages[i], pageSize);
+
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(firstSlot) * pageSize);
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.flush();
+}
+
+// One seek + one read for a whole run of adjacent slots
+void FileBackingStore::readSlotRun(uint32_t firstSlot, const std::vector<uint8_t*>& pages) {
+    std::vector<char> buffer(pages.size() * pageSize);
+
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(firstSlot) * pageSize);
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    for (size_t i = 0; i < pages.size(); ++i)
+        std::memcpy(pages[i], buffer.data() + i * pageSize, pageSize);
+}
+
+// Reopens the swap file without truncating it
+void FileBackingStore::openFile() {
+    file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open())
+        throw std::runtime_error("Failed to reopen backing store \"" + filename + "\"");
+}
+
+void FileBackingStore::closeFile() {
+    file.close();
+}
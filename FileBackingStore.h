@@ -0,0 +1,35 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+
+#include "BackingStore.h"
+
+/**
+ * @class FileBackingStore
+ * @brief BackingStore that keeps its slots in a binary file accessed through std::fstream.
+ *
+ * Each page-in or page-out is one seek followed by one pageSize read or write.
+ * A run of adjacent slots from a batched read or write is one seek and one read or write.
+ */
+class FileBackingStore : public BackingStore {
+public:
+    /**
+     * @brief Creates (or truncates) the swap file.
+     * @param filename Path of the binary swap file.
+     * @param pageSize Size of one page/slot in bytes.
+     */
+    FileBackingStore(const std::string& filename, uint32_t pageSize);
+
+protected:
+    void readSlot(uint32_t slot, uint8_t* dest) override;
+    void writeSlot(uint32_t slot, const uint8_t* src) override;
+    void writeSlotRun(uint32_t firstSlot, const std::vector<const uint8_t*>& pages) override;
+    void readSlotRun(uint32_t firstSlot, const std::vector<uint8_t*>& pages) override;
+    void openFile() override;
+    void closeFile() override;
+
+private:
+    std::string filename;
+    std::fstream file;
+};
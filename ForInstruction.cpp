@@ -38,4 +38,8 @@ std::string ForInstruction::toString() const {
     std::stringstream ss;
     ss << "FOR " << loopCount << " times";
     return ss.str();
+}
+
+std::string ForInstruction::toSource() const {
+    return "FOR " + std::to_string(loopCount);
 }
\ No newline at end of file
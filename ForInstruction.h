@@ -57,6 +57,17 @@ public:
      */
     std::string toString() const override;
 
+
+
+
+    /**
+     * @brief Loops are flattened before a process is created, so this only
+     *        names the loop; Instruction::fromString does not parse it.
+     *
+     * @return std::string "FOR <count>".
+     */
+    std::string toSource() const override;
+
 private:
     int loopCount;  // Total number of iterations to perform
     int layer;      // Nesting Depth for log formatting of nested loops
@@ -0,0 +1,98 @@
+#include "FrameAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+FrameAllocator::FrameAllocator(uint32_t totalFrames)
+    : totalFrames(totalFrames), freeCount(totalFrames),
+      freeMasks((static_cast<uint64_t>(totalFrames) + HUGE_FRAME_PAGES - 1) / HUGE_FRAME_PAGES) {
+    for (uint32_t hugeFrame = 0; hugeFrame < freeMasks.size(); ++hugeFrame) {
+        freeMasks[hugeFrame] = allFreeMask(hugeFrame);
+
+        // A trailing partial huge frame can never be handed out whole
+        if ((hugeFrame + 1) * HUGE_FRAME_PAGES <= totalFrames)
+            wholeHugeFrames.insert(hugeFrame);
+        else
+            splitHugeFrames.insert(hugeFrame);
+    }
+}
+
+// Lowest free frame of the lowest split huge frame, splitting a whole one only if needed
+std::optional<uint32_t> FrameAllocator::allocate() {
+    uint32_t hugeFrame;
+    if (!splitHugeFrames.empty()) {
+        hugeFrame = *splitHugeFrames.begin();
+    } else if (!wholeHugeFrames.empty()) {
+        hugeFrame = *wholeHugeFrames.begin();
+        wholeHugeFrames.erase(wholeHugeFrames.begin());
+        splitHugeFrames.insert(hugeFrame);
+    } else {
+        return std::nullopt;
+    }
+
+    uint16_t& mask = freeMasks[hugeFrame];
+    uint32_t index = static_cast<uint32_t>(std::countr_zero(mask));
+    mask &= static_cast<uint16_t>(~(1u << index));
+    if (mask == 0)
+        splitHugeFrames.erase(hugeFrame);
+
+    --freeCount;
+    return hugeFrame * HUGE_FRAME_PAGES + index;
+}
+
+std::optional<uint32_t> FrameAllocator::allocateHuge() {
+    if (wholeHugeFrames.empty()) return std::nullopt;
+
+    uint32_t hugeFrame = *wholeHugeFrames.begin();
+    wholeHugeFrames.erase(wholeHugeFrames.begin());
+    freeMasks[hugeFrame] = 0;
+
+    freeCount -= HUGE_FRAME_PAGES;
+    return hugeFrame * HUGE_FRAME_PAGES;
+}
+
+bool FrameAllocator::take(uint32_t frameNumber) {
+    uint32_t hugeFrame = frameNumber / HUGE_FRAME_PAGES;
+    uint16_t bit = static_cast<uint16_t>(1u << (frameNumber % HUGE_FRAME_PAGES));
+    uint16_t& mask = freeMasks[hugeFrame];
+    if (!(mask & bit)) return false;
+
+    // Taking a frame out of a whole huge frame splits it
+    wholeHugeFrames.erase(hugeFrame);
+    mask &= static_cast<uint16_t>(~bit);
+    if (mask == 0)
+        splitHugeFrames.erase(hugeFrame);
+    else
+        splitHugeFrames.insert(hugeFrame);
+
+    --freeCount;
+    return true;
+}
+
+void FrameAllocator::release(uint32_t frameNumber) {
+    uint32_t hugeFrame = frameNumber / HUGE_FRAME_PAGES;
+    uint16_t bit = static_cast<uint16_t>(1u << (frameNumber % HUGE_FRAME_PAGES));
+    uint16_t& mask = freeMasks[hugeFrame];
+    if (mask & bit) return;
+
+    mask |= bit;
+    ++freeCount;
+
+    // Coalesce: the last frame of a split huge frame came back
+    if (mask == allFreeMask(hugeFrame) && (hugeFrame + 1) * HUGE_FRAME_PAGES <= totalFrames) {
+        splitHugeFrames.erase(hugeFrame);
+        wholeHugeFrames.insert(hugeFrame);
+    } else {
+        splitHugeFrames.insert(hugeFrame);
+    }
+}
+
+bool FrameAllocator::isFree(uint32_t frameNumber) const {
+    return freeMasks[frameNumber / HUGE_FRAME_PAGES] & (1u << (frameNumber % HUGE_FRAME_PAGES));
+}
+
+// Mask with a bit for every base frame that exists in the huge frame
+uint16_t FrameAllocator::allFreeMask(uint32_t hugeFrame) const {
+    uint32_t frames = std::min(HUGE_FRAME_PAGES, totalFrames - hugeFrame * HUGE_FRAME_PAGES);
+    return static_cast<uint16_t>((1u << frames) - 1);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <vector>
+
+/**
+ * @class FrameAllocator
+ * @brief Free-frame allocator that groups physical frames into huge frames.
+ *
+ * Memory is divided into aligned huge frames of HUGE_FRAME_PAGES base frames each.
+ * A huge frame is either whole (every frame free), split (some frames free) or full.
+ * Base frames come from the lowest split huge frame first and a whole one is only
+ * split when no split one has a free frame left, so whole huge frames stay available
+ * for as long as possible. When the last frame of a split huge frame is released it
+ * coalesces back into a whole one. Frames past the last full huge frame are only ever
+ * handed out as base frames.
+ */
+class FrameAllocator {
+public:
+    static constexpr uint32_t HUGE_FRAME_PAGES = 16;
+
+    FrameAllocator() = default;
+
+    /**
+     * @brief Creates an allocator with frames [0, totalFrames) all free.
+     */
+    explicit FrameAllocator(uint32_t totalFrames);
+
+    /**
+     * @brief Takes one base frame, or returns std::nullopt if none is free.
+     */
+    std::optional<uint32_t> allocate();
+
+    /**
+     * @brief Takes a whole huge frame and returns its first base frame, or std::nullopt
+     *        if every huge frame is at least partly in use.
+     */
+    std::optional<uint32_t> allocateHuge();
+
+    /**
+     * @brief Takes one specific free base frame (used by compaction to pick its destination).
+     * @return false if the frame is not free.
+     */
+    bool take(uint32_t frameNumber);
+
+    /**
+     * @brief Returns a base frame; its huge frame coalesces once all of its frames are free.
+     */
+    void release(uint32_t frameNumber);
+
+    bool isFree(uint32_t frameNumber) const;
+    uint32_t getFreeCount() const { return freeCount; }
+    uint32_t getFreeHugeCount() const { return static_cast<uint32_t>(wholeHugeFrames.size()); }
+    uint32_t getHugeFrameCount() const { return totalFrames / HUGE_FRAME_PAGES; }
+
+private:
+    uint16_t allFreeMask(uint32_t hugeFrame) const;
+
+    uint32_t totalFrames = 0;
+    uint32_t freeCount = 0;
+    std::vector<uint16_t> freeMasks;        // One bit per base frame of each huge frame, set if free
+    std::set<uint32_t> splitHugeFrames;     // Huge frames with some, but not all, frames free
+    std::set<uint32_t> wholeHugeFrames;     // Huge frames with every frame free
+
+    static_assert(HUGE_FRAME_PAGES <= 16, "freeMasks holds one bit per base frame");
+};
@@ -48,6 +48,11 @@ void GlobalScheduler::addProcess(std::shared_ptr<Process> process) {
     else std::cerr << "Error: No scheduler is currently set.\n";
 }
 
+// Puts an already known process (e.g. one woken by the MemoryManager) back in the ready queue
+void GlobalScheduler::requeueProcess(std::shared_ptr<Process> process) {
+    if (currentScheduler) currentScheduler->requeueProcess(process);
+}
+
 std::vector<std::shared_ptr<Process>> GlobalScheduler::getAllProcesses() const {
     if (currentScheduler) return currentScheduler->getAllProcesses();
     else return {};
@@ -78,4 +83,21 @@ bool GlobalScheduler::isRunning() {
 
 std::vector<Core*> GlobalScheduler::getCores() const {
     return currentScheduler->getCores();
-}
\ No newline at end of file
+}
+
+// Stops the current scheduler at a tick boundary with every core idle (see Scheduler::pause)
+void GlobalScheduler::pause() {
+    if (currentScheduler) currentScheduler->pause();
+}
+
+void GlobalScheduler::resume() {
+    if (currentScheduler) currentScheduler->resume();
+}
+
+std::vector<std::shared_ptr<Process>> GlobalScheduler::getReadyQueue() const {
+    return currentScheduler ? currentScheduler->getReadyQueue() : std::vector<std::shared_ptr<Process>>{};
+}
+
+void GlobalScheduler::replaceProcesses(std::vector<std::shared_ptr<Process>> processes, std::vector<std::shared_ptr<Process>> ready) {
+    if (currentScheduler) currentScheduler->replaceProcesses(std::move(processes), std::move(ready));
+}
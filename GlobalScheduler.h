@@ -19,21 +19,34 @@ public:
     void stop();
     
     void addProcess(std::shared_ptr<Process> process);
+    void requeueProcess(std::shared_ptr<Process> process);
     std::vector<std::shared_ptr<Process>> getAllProcesses() const;
     void setCurrentScheduler(std::string name);
 	void notifyScheduler();
     std::vector<Core*> getCores() const;
 
+    void pause();
+    void resume();
+    std::vector<std::shared_ptr<Process>> getReadyQueue() const;
+    void replaceProcesses(std::vector<std::shared_ptr<Process>> processes, std::vector<std::shared_ptr<Process>> ready);
+
     bool allCoresFree() const;
     bool noProcessFinished() const;
     bool isRunning();
 
     void incrementIdleTicks() { ++idleTicks; }
     void incrementActiveTicks() { ++activeTicks; }
+    void incrementDeferredDispatches() { ++deferredDispatches; }
 
     uint64_t getIdleTicks() const { return idleTicks; }
     uint64_t getActiveTicks() const { return activeTicks; }
     uint64_t getTotalTicks() const { return idleTicks + activeTicks; }
+    uint64_t getDeferredDispatches() const { return deferredDispatches; }
+    void restoreTickCounters(uint64_t idle, uint64_t active, uint64_t deferred) {
+        idleTicks = idle;
+        activeTicks = active;
+        deferredDispatches = deferred;
+    }
 
 private:
     GlobalScheduler(const SystemConfig& config);
@@ -46,4 +59,5 @@ private:
 
     uint64_t idleTicks = 0;
     uint64_t activeTicks = 0;
+    uint64_t deferredDispatches = 0;
 };
\ No newline at end of file
@@ -1,4 +1,8 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 
-inline constexpr auto TICK_PERIOD = std::chrono::milliseconds(1000);
\ No newline at end of file
+inline constexpr auto TICK_PERIOD = std::chrono::milliseconds(1000);
+
+// Dispatch attempts a Ready process may be passed over for lack of memory before it runs anyway
+inline constexpr uint32_t MAX_DISPATCH_DEFERRALS = 16;
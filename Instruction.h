@@ -3,6 +3,7 @@
 #include <memory>  
 #include <string>
 #include <sstream>
+#include <variant>
 
 #include "Process.h"  
 #include "ConsoleUtil.h" 
@@ -20,7 +21,23 @@ public:
 
     virtual int execute(Process& process) = 0;  
     virtual std::string toString() const = 0;  
+
+    /**
+     * @brief Returns the instruction in the syntax Instruction::fromString parses,
+     *        so a checkpoint can rebuild it exactly.
+     */
+    virtual std::string toSource() const = 0;
+
     virtual bool isComplete(int pid) const { return true; }
 
     static std::shared_ptr<Instruction> fromString(const std::string& line);
+
+protected:
+    // Writes a variable name or an immediate value the way fromString reads it back
+    template <typename Immediate>
+    static std::string operandToSource(const std::variant<std::string, Immediate>& operand) {
+        if (std::holds_alternative<std::string>(operand))
+            return std::get<std::string>(operand);
+        return std::to_string(std::get<Immediate>(operand));
+    }
 };
\ No newline at end of file
@@ -1,4 +1,6 @@
-﻿#include <random>
+﻿#include <algorithm>
+#include <cstdint>
+#include <random>
 #include <sstream>
 #include <unordered_set>
 #include <variant>
@@ -30,7 +32,7 @@ constexpr int MAX_FOR_DEPTH = 2;
 std::vector<std::shared_ptr<Instruction>> InstructionGenerator::generateInstructions(
     int pid,
     const SystemConfig& config,
-    uint16_t allocatedMemory
+    uint32_t allocatedMemory
 ) {
     // Randomly determine the number of instructions to generate
     int count = std::uniform_int_distribution<>(
@@ -87,11 +89,23 @@ std::shared_ptr<Instruction> InstructionGenerator::randomInstruction(
     std::unordered_set<std::string>& declaredVars,
     std::unordered_map<std::string, uint16_t>& addressVars,
     const SystemConfig& config,
-    uint16_t allocatedMemory,
+    uint32_t allocatedMemory,
     int layer
 ) {
     enum { PRINT = 0, DECLARE, ADD, SUB, SLEEP, FOR, READ, WRITE };
 
+    // READ/WRITE address: an address variable, or an immediate one half the time when the
+    // process has more memory than a 16-bit variable can address
+    const bool wideMemory = allocatedMemory > UINT16_MAX + 2u;
+    auto makeAddress = [&]() -> std::variant<std::string, uint32_t> {
+        if (wideMemory && (addressVars.empty() || std::uniform_int_distribution<>(0, 1)(rng) == 0))
+            return std::uniform_int_distribution<uint32_t>(0, allocatedMemory - 2)(rng);
+
+        auto it = addressVars.begin();
+        std::advance(it, std::uniform_int_distribution<>(0, addressVars.size() - 1)(rng));
+        return it->first;
+    };
+
     int choice = std::uniform_int_distribution<>(0, 7)(rng);
 
     switch (choice) {
@@ -120,9 +134,10 @@ std::shared_ptr<Instruction> InstructionGenerator::randomInstruction(
         uint16_t value;
 
         if (isAddress) {
-            // Address variable: pick a valid address
+            // Address variable: pick a valid address (variables are 16-bit, so within the first 64 KiB)
             if (allocatedMemory < 2) return std::make_shared<PrintInstruction>(PrintType::Hello);
-            value = std::uniform_int_distribution<uint16_t>(0, allocatedMemory - 2)(rng);
+            uint32_t highest = std::min<uint32_t>(allocatedMemory - 2, UINT16_MAX);
+            value = static_cast<uint16_t>(std::uniform_int_distribution<uint32_t>(0, highest)(rng));
             addressVars[var] = value;
         } else {
             // Regular variable: random value
@@ -195,31 +210,25 @@ std::shared_ptr<Instruction> InstructionGenerator::randomInstruction(
 
     case READ: {
         // Read from an address variable into a new variable
-        if (addressVars.empty()) break;
+        if (addressVars.empty() && !wideMemory) break;
 
         std::string targetVar = randomVarName();
         declaredVars.insert(targetVar);
 
-        auto it = addressVars.begin();
-        std::advance(it, std::uniform_int_distribution<>(0, addressVars.size() - 1)(rng));
-        std::string addrVar = it->first;
-
-        return std::make_shared<ReadInstruction>(targetVar, addrVar);
+        return std::make_shared<ReadInstruction>(targetVar, makeAddress());
     }
 
     case WRITE: {
         // Write a variable's value to an address variable
-        if (addressVars.empty() || declaredVars.empty()) break;
+        if ((addressVars.empty() && !wideMemory) || declaredVars.empty()) break;
 
-        auto it = addressVars.begin();
-        std::advance(it, std::uniform_int_distribution<>(0, addressVars.size() - 1)(rng));
-        std::string addrVar = it->first;
+        auto addr = makeAddress();
 
         auto it2 = declaredVars.begin();
         std::advance(it2, std::uniform_int_distribution<>(0, declaredVars.size() - 1)(rng));
         std::string valVar = *it2;
 
-        return std::make_shared<WriteInstruction>(addrVar, valVar);
+        return std::make_shared<WriteInstruction>(addr, valVar);
     }
     }
     // Fallback: print hello if no valid instruction was generated
@@ -24,7 +24,7 @@ public:
      * @param allocatedMemory The amount of memory allocated to the process.
      * @return A vector of shared pointers to generated Instruction objects.
      */
-    static std::vector<std::shared_ptr<Instruction>> generateInstructions(int pid, const SystemConfig& config, uint16_t allocatedMemory);
+    static std::vector<std::shared_ptr<Instruction>> generateInstructions(int pid, const SystemConfig& config, uint32_t allocatedMemory);
 
 private:
     /**
@@ -37,7 +37,7 @@ private:
      * @param layer The current recursion layer (default is 0).
      * @return A shared pointer to the generated Instruction.
      */
-    static std::shared_ptr<Instruction> randomInstruction(int pid, std::unordered_set<std::string>& declaredVars, std::unordered_map<std::string, uint16_t>& addressVars, const SystemConfig& config, uint16_t allocatedMemory, int layer = 0);
+    static std::shared_ptr<Instruction> randomInstruction(int pid, std::unordered_set<std::string>& declaredVars, std::unordered_map<std::string, uint16_t>& addressVars, const SystemConfig& config, uint32_t allocatedMemory, int layer = 0);
 
     /**
      * @brief Generates a random variable name.
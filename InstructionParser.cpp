@@ -3,6 +3,10 @@
 #include "DeclareInstruction.h"
 #include "PrintInstruction.h"
 #include "ReadInstruction.h"
+#include "ShmAttachInstruction.h"
+#include "ShmOpenInstruction.h"
+#include "SleepInstruction.h"
+#include "SubtractInstruction.h"
 #include "WriteInstruction.h"
 #include "ConsoleUtil.h"
 
@@ -19,6 +23,14 @@ static std::variant<std::string, uint16_t> parseOperand(const std::string& token
     return token;
 }
 
+// Same as parseOperand, but immediates are 32-bit so they can address past 64 KiB
+static std::variant<std::string, uint32_t> parseAddressOperand(const std::string& token) {
+    if ((token.rfind("0x", 0) == 0) || std::all_of(token.begin(), token.end(), ::isdigit)) {
+        return static_cast<uint32_t>(std::stoul(token, nullptr, 0));
+    }
+    return token;
+}
+
 /**
  * @brief Parses a single line of text and constructs the corresponding Instruction object.
  *
@@ -29,8 +41,12 @@ static std::variant<std::string, uint16_t> parseOperand(const std::string& token
  * Supported instructions:
  * - DECLARE <var> <value>: Declares a variable with a given value.
  * - ADD <target> <op1> <op2>: Adds two operands and stores the result in target.
+ * - SUBTRACT <target> <op1> <op2>: Subtracts op2 from op1 and stores the result in target.
+ * - SLEEP <ticks>: Sleeps for the given number of ticks.
  * - WRITE <addr> <val>: Writes a value to a memory address.
  * - READ <target> <addr>: Reads a value from a memory address into target.
+ * - SHM_OPEN <name> <size>: Opens a shared-memory segment, creating it with size bytes if needed.
+ * - SHM_ATTACH <name> <addr>: Maps an open shared-memory segment at a page-aligned address.
  * - PRINT(...): Prints a literal, variable, expression, or "Hello".
  *
  * @param line The input string representing a single instruction line.
@@ -64,16 +80,46 @@ std::shared_ptr<Instruction> Instruction::fromString(const std::string& line) {
         return std::make_shared<AddInstruction>(target, parseOperand(op1), parseOperand(op2));
     }
 
+    if (keyword == "SUBTRACT") {
+        std::string target, op1, op2;
+        iss >> target >> op1 >> op2;
+        return std::make_shared<SubtractInstruction>(target, parseOperand(op1), parseOperand(op2));
+    }
+
+    if (keyword == "SLEEP") {
+        unsigned int ticks = 0;
+        iss >> ticks;
+        return std::make_shared<SleepInstruction>(static_cast<uint8_t>(ticks));
+    }
+
     if (keyword == "WRITE") {
         std::string addr, val;
         iss >> addr >> val;
-        return std::make_shared<WriteInstruction>(parseOperand(addr), parseOperand(val));
+        return std::make_shared<WriteInstruction>(parseAddressOperand(addr), parseOperand(val));
     }
 
     if (keyword == "READ") {
         std::string target, addr;
         iss >> target >> addr;
-        return std::make_shared<ReadInstruction>(target, parseOperand(addr));
+        return std::make_shared<ReadInstruction>(target, parseAddressOperand(addr));
+    }
+
+    if (keyword == "SHM_OPEN") {
+        std::string name, size;
+        iss >> name >> size;
+        if (name.empty() || size.empty()) {
+            throw std::runtime_error("Invalid SHM_OPEN syntax: " + line);
+        }
+        return std::make_shared<ShmOpenInstruction>(name, parseAddressOperand(size));
+    }
+
+    if (keyword == "SHM_ATTACH") {
+        std::string name, addr;
+        iss >> name >> addr;
+        if (name.empty() || addr.empty()) {
+            throw std::runtime_error("Invalid SHM_ATTACH syntax: " + line);
+        }
+        return std::make_shared<ShmAttachInstruction>(name, parseAddressOperand(addr));
     }
 
     if (keyword == "PRINT") {
@@ -0,0 +1,59 @@
+#include <algorithm>
+
+#include "LFUPolicy.h"
+
+LFUPolicy::LFUPolicy(uint32_t totalFrames)
+    : accessCount(totalFrames), loadTime(totalFrames, 0) {
+}
+
+void LFUPolicy::onPageLoaded(uint32_t frameNumber) {
+    accessCount[frameNumber] = 1;
+    loadTime[frameNumber] = ++clock;
+}
+
+void LFUPolicy::onPageAccessed(uint32_t frameNumber) {
+    if (accessCount[frameNumber] != 0)
+        ++accessCount[frameNumber];
+}
+
+void LFUPolicy::onFrameFreed(uint32_t frameNumber) {
+    accessCount[frameNumber] = 0;
+}
+
+void LFUPolicy::onFrameMoved(uint32_t from, uint32_t to) {
+    accessCount[to] = accessCount[from].load();
+    loadTime[to] = loadTime[from];
+    accessCount[from] = 0;
+}
+
+// Fewer accesses first, then the older page
+bool LFUPolicy::isBetterVictim(uint32_t a, uint32_t b) const {
+    if (accessCount[a] != accessCount[b]) return accessCount[a] < accessCount[b];
+    return loadTime[a] < loadTime[b];
+}
+
+// Evicts the tracked frame with the lowest access count
+std::optional<uint32_t> LFUPolicy::selectVictim(const ReferenceProbe& /*testAndClearReferenced*/) {
+    std::optional<uint32_t> victim;
+    for (uint32_t frame = 0; frame < accessCount.size(); ++frame) {
+        if (accessCount[frame] == 0) continue;
+        if (!victim || isBetterVictim(frame, *victim))
+            victim = frame;
+    }
+
+    if (victim) onFrameFreed(*victim);
+    return victim;
+}
+
+std::vector<uint32_t> LFUPolicy::peekVictims(size_t count) const {
+    std::vector<uint32_t> frames;
+    for (uint32_t frame = 0; frame < accessCount.size(); ++frame) {
+        if (accessCount[frame] != 0) frames.push_back(frame);
+    }
+
+    count = std::min(count, frames.size());
+    std::partial_sort(frames.begin(), frames.begin() + count, frames.end(),
+                      [this](uint32_t a, uint32_t b) { return isBetterVictim(a, b); });
+    frames.resize(count);
+    return frames;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "PageReplacementPolicy.h"
+
+/**
+ * @class LFUPolicy
+ * @brief Least-frequently-used replacement; ties are broken by evicting the frame loaded first.
+ */
+class LFUPolicy : public PageReplacementPolicy {
+public:
+    LFUPolicy(uint32_t totalFrames);
+
+    void onPageLoaded(uint32_t frameNumber) override;
+    void onPageAccessed(uint32_t frameNumber) override;
+    void onFrameFreed(uint32_t frameNumber) override;
+    void onFrameMoved(uint32_t from, uint32_t to) override;
+    std::optional<uint32_t> selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+    std::vector<uint32_t> peekVictims(size_t count) const override;
+    std::string getName() const override { return "lfu"; }
+
+private:
+    bool isBetterVictim(uint32_t a, uint32_t b) const;
+
+    // Accesses since the page was loaded, 0 if not tracked. Atomic because onPageAccessed
+    // runs concurrently on every core under the MemoryManager's shared lock.
+    std::vector<std::atomic<uint64_t>> accessCount;
+    std::vector<uint64_t> loadTime;     // Logical time the page was loaded
+    uint64_t clock = 0;
+};
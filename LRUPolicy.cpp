@@ -0,0 +1,51 @@
+#include <algorithm>
+
+#include "LRUPolicy.h"
+
+LRUPolicy::LRUPolicy(uint32_t totalFrames)
+    : lastAccess(totalFrames) {
+}
+
+void LRUPolicy::onPageLoaded(uint32_t frameNumber) {
+    lastAccess[frameNumber] = ++clock;
+}
+
+void LRUPolicy::onPageAccessed(uint32_t frameNumber) {
+    if (lastAccess[frameNumber] != NOT_TRACKED)
+        lastAccess[frameNumber] = ++clock;
+}
+
+void LRUPolicy::onFrameFreed(uint32_t frameNumber) {
+    lastAccess[frameNumber] = NOT_TRACKED;
+}
+
+void LRUPolicy::onFrameMoved(uint32_t from, uint32_t to) {
+    lastAccess[to] = lastAccess[from].load();
+    lastAccess[from] = NOT_TRACKED;
+}
+
+// Evicts the tracked frame with the oldest access time
+std::optional<uint32_t> LRUPolicy::selectVictim(const ReferenceProbe& /*testAndClearReferenced*/) {
+    std::optional<uint32_t> victim;
+    for (uint32_t frame = 0; frame < lastAccess.size(); ++frame) {
+        if (lastAccess[frame] == NOT_TRACKED) continue;
+        if (!victim || lastAccess[frame] < lastAccess[*victim])
+            victim = frame;
+    }
+
+    if (victim) onFrameFreed(*victim);
+    return victim;
+}
+
+std::vector<uint32_t> LRUPolicy::peekVictims(size_t count) const {
+    std::vector<uint32_t> frames;
+    for (uint32_t frame = 0; frame < lastAccess.size(); ++frame) {
+        if (lastAccess[frame] != NOT_TRACKED) frames.push_back(frame);
+    }
+
+    count = std::min(count, frames.size());
+    std::partial_sort(frames.begin(), frames.begin() + count, frames.end(),
+                      [this](uint32_t a, uint32_t b) { return lastAccess[a] < lastAccess[b]; });
+    frames.resize(count);
+    return frames;
+}
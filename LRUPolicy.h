@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "PageReplacementPolicy.h"
+
+/**
+ * @class LRUPolicy
+ * @brief Exact least-recently-used replacement based on a per-frame logical access time.
+ */
+class LRUPolicy : public PageReplacementPolicy {
+public:
+    LRUPolicy(uint32_t totalFrames);
+
+    void onPageLoaded(uint32_t frameNumber) override;
+    void onPageAccessed(uint32_t frameNumber) override;
+    void onFrameFreed(uint32_t frameNumber) override;
+    void onFrameMoved(uint32_t from, uint32_t to) override;
+    std::optional<uint32_t> selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+    std::vector<uint32_t> peekVictims(size_t count) const override;
+    std::string getName() const override { return "lru"; }
+
+private:
+    static constexpr uint64_t NOT_TRACKED = 0;
+
+    // Logical time of the last access per frame, 0 if not tracked. Atomic because
+    // onPageAccessed runs concurrently on every core under the MemoryManager's shared lock.
+    std::vector<std::atomic<uint64_t>> lastAccess;
+    std::atomic<uint64_t> clock = 0;
+};
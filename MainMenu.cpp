@@ -11,6 +11,7 @@
 #include "ColorUtil.h"
 #include "ConsoleUtil.h"
 #include "GlobalScheduler.h"
+#include "Checkpoint.h"
 #include "InstructionGenerator.h"
 #include "MemoryManager.h"
 #include "Globals.h"
@@ -61,13 +62,17 @@ void MainMenu::render() {
     std::cout << "│  [03] screen -r <name>                                      - Resume an existing screen session          |" << std::endl;
     std::cout << "│  [04] screen -c <name> <memory size> \"<instructions>\"       - Create a custom screen session             │" << std::endl;
     std::cout << "│  [05] screen -ls                                            - List all existing screen sessions          │" << std::endl;
-    std::cout << "│  [06] scheduler-start                                       - Run scheduler suite                        │" << std::endl;
-    std::cout << "│  [07] scheduler-stop                                        - Stop all scheduler processes               │" << std::endl;
-    std::cout << "│  [08] report-util                                           - Generate system utilization report         │" << std::endl;
-    std::cout << "│  [09] process-smi                                           - Process System Management Interrupt (SMI)  │" << std::endl;
-    std::cout << "│  [10] vmstat                                                - Display virtual memory statistics          │" << std::endl;
-    std::cout << "│  [11] clear                                                 - Clear the console display                  │" << std::endl;
-    std::cout << "│  [12] exit                                                  - Exit the console emulator                  │" << std::endl;
+    std::cout << "│  [06] screen -clone <source> <name>                         - Clone a process with copy-on-write memory  │" << std::endl;
+    std::cout << "│  [07] scheduler-start                                       - Run scheduler suite                        │" << std::endl;
+    std::cout << "│  [08] scheduler-stop                                        - Stop all scheduler processes               │" << std::endl;
+    std::cout << "│  [09] report-util                                           - Generate system utilization report         │" << std::endl;
+    std::cout << "│  [10] process-smi                                           - Process System Management Interrupt (SMI)  │" << std::endl;
+    std::cout << "│  [11] vmstat                                                - Display virtual memory statistics          │" << std::endl;
+    std::cout << "│  [12] compact                                               - Compact physical memory                    │" << std::endl;
+    std::cout << "│  [13] checkpoint [-i] <file>                                - Save the system (-i: only what changed)    │" << std::endl;
+    std::cout << "│  [14] restore <file>                                        - Restore the system from a checkpoint file  │" << std::endl;
+    std::cout << "│  [15] clear                                                 - Clear the console display                  │" << std::endl;
+    std::cout << "│  [16] exit                                                  - Exit the console emulator                  │" << std::endl;
     std::cout << "│                                                                                                          │" << std::endl;
     std::cout << "└──────────────────────────────────────────────────────────────────────────────────────────────────────────┘" << std::endl;
 }
@@ -88,6 +93,7 @@ bool MainMenu::processInput(const std::string input) {
         if (ConsoleSystem::getInstance()->isInitialized()) {
             CU::printColoredText(Color::Yellow, "[!] Exiting the system. Please wait...\n");
             GlobalScheduler::getInstance()->stop();
+            MemoryManager::getInstance()->shutdown();
             ConsoleSystem::getInstance()->exit();
         }
         ConsoleSystem::getInstance()->exit();
@@ -107,7 +113,7 @@ bool MainMenu::processInput(const std::string input) {
         GlobalScheduler::getInstance()->start();
     }
     // Handle commands that require system initialization
-    else if (command == "scheduler-start" || command == "scheduler-stop" || command == "report-util" || command == "screen" || command == "process-smi" || command == "vmstat") {
+    else if (command == "scheduler-start" || command == "scheduler-stop" || command == "report-util" || command == "screen" || command == "process-smi" || command == "vmstat" || command == "compact" || command == "checkpoint" || command == "restore") {
         if (!ConsoleSystem::getInstance()->isInitialized()) {
             CU::printColoredText(Color::Red, "[X] Please initialize the system first.\n");
             return false;
@@ -119,7 +125,7 @@ bool MainMenu::processInput(const std::string input) {
             if (tokens.size() == 4 && tokens[1] == "-s") {
                 const std::string& process_name = tokens[2];
                 try {
-                    int memSize = std::stoi(tokens[3]);
+                    uint32_t memSize = static_cast<uint32_t>(std::stoul(tokens[3]));
                     screenStart(process_name, memSize);
                 } catch (...) {
                     CU::printColoredText(Color::Red, "[X] Invalid memory size. Usage: screen -s <name> <memory_size>\n");
@@ -129,6 +135,10 @@ bool MainMenu::processInput(const std::string input) {
             else if (tokens.size() == 3 && tokens[1] == "-r") {
                 screenResume(tokens[2]);
             }
+            // Clone an existing process into a new screen session
+            else if (tokens.size() == 4 && tokens[1] == "-clone") {
+                screenClone(tokens[2], tokens[3]);
+            }
             // List all existing screen sessions
             else if (tokens.size() == 2 && tokens[1] == "-ls") {
                 screenList();
@@ -140,7 +150,7 @@ bool MainMenu::processInput(const std::string input) {
                 std::string rawInstructions;
 
                 try {
-                    uint16_t memSize = static_cast<uint16_t>(std::stoul(memSizeStr));
+                    uint32_t memSize = static_cast<uint32_t>(std::stoul(memSizeStr));
 
                     // Concatenate all instruction tokens into a single string
                     for (size_t i = 4; i < tokens.size(); ++i) {
@@ -162,7 +172,7 @@ bool MainMenu::processInput(const std::string input) {
             }
             // Invalid usage of "screen" command
             else {
-                CU::printColoredText(Color::Red, "[X] Proper Usage: screen -s <name> <memory_size>, screen -r <name>, screen -c <name> <memory_size> \"<instructions>\", or screen -ls.\n");
+                CU::printColoredText(Color::Red, "[X] Proper Usage: screen -s <name> <memory_size>, screen -r <name>, screen -c <name> <memory_size> \"<instructions>\", screen -clone <source> <name>, or screen -ls.\n");
             }
         }
         // Start scheduler test batch
@@ -185,6 +195,27 @@ bool MainMenu::processInput(const std::string input) {
         else if (command == "vmstat") {
             VMStat();
         }
+        // Compact physical memory
+        else if (command == "compact") {
+            compact();
+        }
+        // Save or restore the whole system
+        else if (command == "checkpoint") {
+            if (tokens.size() == 2 && tokens[1] != "-i") {
+                checkpoint(tokens[1], false);
+            } else if (tokens.size() == 3 && tokens[1] == "-i") {
+                checkpoint(tokens[2], true);
+            } else {
+                CU::printColoredText(Color::Red, "[X] Proper Usage: checkpoint [-i] <file>\n");
+            }
+        }
+        else if (command == "restore") {
+            if (tokens.size() != 2) {
+                CU::printColoredText(Color::Red, "[X] Proper Usage: restore <file>\n");
+            } else {
+                restore(tokens[1]);
+            }
+        }
     }
     // Handle invalid commands
     else {
@@ -194,7 +225,7 @@ bool MainMenu::processInput(const std::string input) {
     return false;
 }
 
-void MainMenu::screenStart(const std::string& process_name, int memorySize) {
+void MainMenu::screenStart(const std::string& process_name, uint32_t memorySize) {
     const SystemConfig& config = ConsoleSystem::getInstance()->getConfig();
 
     // Check if memory size is within allowed range
@@ -282,7 +313,7 @@ void MainMenu::screenResume(const std::string& process_name) {
     ConsoleSystem::getInstance()->switchLayout("ProcessScreen", process);
 }
 
-void MainMenu::screenCustom(const std::string& name, uint16_t memorySize, const std::string& rawInstructionStr) {
+void MainMenu::screenCustom(const std::string& name, uint32_t memorySize, const std::string& rawInstructionStr) {
     // Get system configuration
     const SystemConfig& config = ConsoleSystem::getInstance()->getConfig();
 
@@ -334,6 +365,49 @@ void MainMenu::screenCustom(const std::string& name, uint16_t memorySize, const
 }
 
 
+void MainMenu::screenClone(const std::string& sourceName, const std::string& name) {
+    // Find the process to clone
+    auto source = ConsoleUtil::findProcessByName(sourceName);
+    if (!source) {
+        CU::printColoredText(Color::Red, "[X] No such process found.\n");
+        return;
+    }
+
+    // Check if a process with the same name already exists
+    if (ConsoleUtil::findProcessByName(name)) {
+        CU::printColoredText(Color::Red, "[X] Process \"" + name + "\" already exists.\n");
+        return;
+    }
+
+    // Pause the cores (as a checkpoint does) so the source's instruction index, variables and
+    // memory are all copied at the same instant, with none of its instructions half done
+    auto scheduler = GlobalScheduler::getInstance();
+    std::shared_ptr<Process> clone;
+    scheduler->pause();
+    try {
+        // Only a process that can still run can be cloned
+        if (source->isFinished() || source->isTerminated()) {
+            scheduler->resume();
+            CU::printColoredText(Color::Red, "[X] Process \"" + sourceName + "\" has already finished and cannot be cloned.\n");
+            return;
+        }
+
+        // Create the clone, register it, then map the source's memory into it copy-on-write
+        clone = source->cloneAs(name);
+        Process::registerProcess(clone);
+        MemoryManager::getInstance()->cloneAddressSpace(*source, *clone);
+    } catch (...) {
+        scheduler->resume();
+        throw;
+    }
+    scheduler->resume();
+    scheduler->addProcess(clone);
+
+    // Notify user of successful clone
+    CU::printColoredText(Color::Green, "[*] Process \"" + name + "\" cloned from \"" + sourceName + "\" (" +
+        std::to_string(MemoryManager::getInstance()->getResidentFrameCount(clone->getPID())) + " frames shared copy-on-write).\n");
+}
+
 void MainMenu::screenList() {
     // Get scheduler, all processes, and CPU cores
     auto scheduler = GlobalScheduler::getInstance();
@@ -658,10 +732,7 @@ void MainMenu::processSMI() {
     const auto& config = ConsoleSystem::getInstance()->getConfig();
 
     // Count used frames in memory
-    uint32_t usedFrames = 0;
-    for (const auto& frame : mm->getFrameTable()) {
-        if (frame.inUse) ++usedFrames;
-    }
+    uint32_t usedFrames = mm->getTotalFrames() - mm->getFreeFrameCount();
 
     // Calculate memory usage statistics
     uint32_t totalMemory = mm->getMemorySize();
@@ -696,7 +767,7 @@ void MainMenu::processSMI() {
     out << std::left
         << std::setw(6) << "PID"
         << std::setw(12) << "Name"
-        << std::setw(18) << "Memory Usage"
+        << std::setw(22) << "Memory Usage"
         << std::setw(7) << "%";
     out << "\n---------------------------------------------------------------------\n";
 
@@ -706,13 +777,8 @@ void MainMenu::processSMI() {
         std::string name = ConsoleUtil::truncateLongNames(process->getName());
         uint32_t memRequired = process->getMemoryRequired();
 
-        // Count frames used by this process
-        uint32_t usedByProcess = 0;
-        for (const auto& frame : mm->getFrameTable()) {
-            if (frame.inUse && frame.pfid == pid) {
-                ++usedByProcess;
-            }
-        }
+        // Frames used by this process
+        uint32_t usedByProcess = mm->getResidentFrameCount(pid);
         uint32_t actualUsedMemory = usedByProcess * mm->getFrameSize();
         float usagePercent = (memRequired == 0) ? 0.0f : (float)actualUsedMemory / memRequired * 100.0f;
 
@@ -720,7 +786,7 @@ void MainMenu::processSMI() {
         out << std::left
             << std::setw(6) << process->getPID()
             << std::setw(12) << name
-            << std::setw(18) << std::to_string(actualUsedMemory) + "/" + std::to_string(memRequired)
+            << std::setw(22) << std::to_string(actualUsedMemory) + "/" + std::to_string(memRequired)
             << std::setw(7) << std::fixed << std::setprecision(2) << usagePercent << "%\n";
     }
 
@@ -728,14 +794,20 @@ void MainMenu::processSMI() {
     std::cout << out.str();
 }
 
+// Requests, I/Os after merging, and per-request queue latency and service time of one swap direction
+static void printSwapIoStats(std::ostringstream& out, const std::string& label, const SwapIoStats& stats) {
+    out << label << stats.requests << " requests in " << stats.operations << " I/Os\n";
+    out << "  Queue Latency:    " << std::fixed << std::setprecision(3) << stats.averageQueueMs()
+        << " ms (avg), " << stats.maxQueueUs / 1000.0 << " ms (max)\n";
+    out << "  Service Time:     " << std::fixed << std::setprecision(3) << stats.averageServiceMs()
+        << " ms (avg), " << stats.maxServiceUs / 1000.0 << " ms (max)\n";
+}
+
 void MainMenu::VMStat() {
     auto mm = MemoryManager::getInstance();
     auto scheduler = GlobalScheduler::getInstance();
 
-    uint32_t usedFrames = 0;
-    for (const auto& frame : mm->getFrameTable()) {
-        if (frame.inUse) ++usedFrames;
-    }
+    uint32_t usedFrames = mm->getTotalFrames() - mm->getFreeFrameCount();
 
     uint32_t totalMemory = mm->getMemorySize();
     uint32_t usedMemory = usedFrames * mm->getFrameSize();
@@ -764,9 +836,104 @@ void MainMenu::VMStat() {
     out << "CPU Ticks (Active): " << scheduler->getActiveTicks() << "\n";
     out << "CPU Ticks (Total):  " << scheduler->getTotalTicks() << "\n";
     out << "---------------------------------------------------------------------\n";
+    out << "Page Replacement:   " << mm->getReplacementPolicyName() << "\n";
+    out << "Page Faults:        " << mm->getPageFaults() << "\n";
+    out << "Huge Frame Faults:  " << mm->getHugePageFaults() << (mm->isHugeFramesEnabled() ? "" : " (disabled)") << "\n";
+    out << "Huge Frames Free:   " << mm->getFreeHugeFrameCount() << " / " << mm->getHugeFrameCount() << "\n";
+    out << "Fragmentation:      " << std::fixed << std::setprecision(2) << mm->getFragmentation() << "% ("
+        << mm->getCompactions() << " compactions, " << mm->getPagesMigrated() << " pages migrated)\n";
     out << "Pages Paged In:     " << mm->getPagesPagedIn() << "\n";
     out << "Pages Paged Out:    " << mm->getPagesPagedOut() << "\n";
+    out << "Zero-fill Faults:   " << mm->getZeroFillFaults() << "\n";
+    out << "Zero Pages Deduped: " << mm->getZeroPagesDeduplicated() << "\n";
+    out << "Swap Slots Used:    " << mm->getUsedSwapSlots() << " (" << mm->getSwapFileCount() << " swap files)\n";
+    out << "Memory Waiters:     " << mm->getMemoryWaitQueueDepth() << "\n";
+    out << "Working Sets:       " << mm->getTotalWorkingSet() << " / " << mm->getTotalFrames() << " frames\n";
+    out << "Admissions Denied:  " << mm->getAdmissionsDenied() << "\n";
+    out << "Dispatch Deferrals: " << scheduler->getDeferredDispatches() << "\n";
+    out << "Local Replacements: " << mm->getLocalReplacements() << "\n";
+    out << "COW Pages Shared:   " << mm->getPagesShared() << "\n";
+    out << "COW Faults:         " << mm->getCopyOnWriteFaults() << "\n";
+    out << "Shared Segments:    " << mm->getSharedSegmentCount() << " (" << mm->getPinnedFrameCount() << " frames pinned)\n";
+    const CompressedPageCache& pool = mm->getCompressedCache();
+    uint64_t poolLookups = pool.getHits() + pool.getMisses();
+    double poolHitRate = poolLookups ? (static_cast<double>(pool.getHits()) / poolLookups) * 100.0 : 0.0;
+    out << "Compressed Pool:    " << pool.getUsedBytes() << " / " << pool.getCapacityBytes() << " bytes (" << pool.getStoredPages() << " pages)\n";
+    out << "Compression Ratio:  " << std::fixed << std::setprecision(2) << pool.getCompressionRatio() << "x\n";
+    out << "Pool Hit Rate:      " << std::fixed << std::setprecision(2) << poolHitRate << "%\n";
+    out << "Pages Prefetched:   " << mm->getPagesPrefetched() << "\n";
+    out << "Prefetch Hits:      " << mm->getPrefetchHits() << "\n";
+    out << "Prefetch Misses:    " << mm->getPrefetchMisses() << "\n";
+    out << "---------------------------------------------------------------------\n";
+    uint64_t tlbHits = mm->getTLBHits();
+    uint64_t tlbLookups = tlbHits + mm->getTLBMisses();
+    double tlbHitRate = tlbLookups ? (static_cast<double>(tlbHits) / tlbLookups) * 100.0 : 0.0;
+    out << "TLB Hits:           " << tlbHits << "\n";
+    out << "TLB Misses:         " << mm->getTLBMisses() << "\n";
+    out << "TLB Hit Rate:       " << std::fixed << std::setprecision(2) << tlbHitRate << "%\n";
+    out << "---------------------------------------------------------------------\n";
+    out << "Write-back Queue:   " << mm->getWriteBackQueueDepth() << " / " << mm->getWriteBackQueueCapacity() << "\n";
+    out << "Pages Written Back: " << mm->getPagesWrittenBack() << "\n";
+    out << "Sync Write-backs:   " << mm->getSyncWriteBacks() << "\n";
+    out << "Write-back Latency: " << std::fixed << std::setprecision(3) << mm->getAverageWriteBackLatencyMs() << " ms (avg)\n";
+    out << "---------------------------------------------------------------------\n";
+    printSwapIoStats(out, "Swap Reads:         ", mm->getSwapIoQueue().getReadStats());
+    printSwapIoStats(out, "Swap Writes:        ", mm->getSwapIoQueue().getWriteStats());
     out << "=====================================================================\n";
 
     std::cout << out.str();
-}
\ No newline at end of file
+}
+
+void MainMenu::compact() {
+    auto mm = MemoryManager::getInstance();
+
+    double before = mm->getFragmentation();
+    uint32_t moved = mm->compactMemory();
+    double after = mm->getFragmentation();
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2)
+        << "[*] Compaction moved " << moved << " page(s). Fragmentation: " << before << "% -> " << after << "%. "
+        << mm->getFreeHugeFrameCount() << " of " << mm->getHugeFrameCount() << " huge frames free.\n";
+    CU::printColoredText(Color::Green, out.str());
+}
+
+void MainMenu::checkpoint(const std::string& path, bool incremental) {
+    try {
+        CheckpointSummary summary = Checkpoint::save(path, incremental);
+
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2);
+        if (incremental) {
+            out << "[*] Incremental checkpoint saved to \"" << path << "\" on top of \"" << summary.parent << "\": "
+                << summary.processesWritten << " of " << summary.processes << " process(es) and "
+                << summary.framesWritten << " frame(s) changed, ";
+        } else {
+            out << "[*] Checkpoint saved to \"" << path << "\": " << summary.processes << " process(es), ";
+        }
+        out << summary.bytes << " bytes. Cores paused for " << summary.pausedMs << " ms.\n";
+        CU::printColoredText(Color::Green, out.str());
+    } catch (const std::exception& e) {
+        CU::printColoredText(Color::Red, std::string("[X] Checkpoint failed: ") + e.what() + "\n");
+    }
+}
+
+void MainMenu::restore(const std::string& path) {
+    // New batch processes would be mixed into the restored system
+    if (testingScheduler) {
+        CU::printColoredText(Color::Red, "[X] Stop the scheduler test batch (scheduler-stop) before restoring a checkpoint.\n");
+        return;
+    }
+
+    try {
+        CheckpointSummary summary = Checkpoint::restore(path);
+
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2)
+            << "[*] Restored " << summary.processes << " process(es) from \"" << path << "\" ("
+            << summary.bytes << " bytes in " << summary.files << " file(s)) in " << summary.pausedMs << " ms.\n";
+        CU::printColoredText(Color::Green, out.str());
+    } catch (const std::exception& e) {
+        CU::printColoredText(Color::Red, std::string("[X] Restore failed: ") + e.what() + "\n");
+    }
+}
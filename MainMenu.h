@@ -54,7 +54,7 @@ private:
      * @param name The name of the screen.
      * @param memorySize The memory size to allocate.
      */
-    void screenStart(const std::string& name, int memorySize);
+    void screenStart(const std::string& name, uint32_t memorySize);
 
     /**
      * @brief Resumes a previously started screen.
@@ -68,7 +68,14 @@ private:
      * @param memorySize The memory size to allocate.
      * @param rawInstructionStr The raw instruction string.
      */
-    void screenCustom(const std::string& name, uint16_t memorySize, const std::string& rawInstructionStr);
+    void screenCustom(const std::string& name, uint32_t memorySize, const std::string& rawInstructionStr);
+
+    /**
+     * @brief Starts a screen running a copy-on-write clone of an existing process.
+     * @param sourceName The name of the process to clone.
+     * @param name The name of the new screen.
+     */
+    void screenClone(const std::string& sourceName, const std::string& name);
 
     /**
      * @brief Lists all available screens.
@@ -99,4 +106,22 @@ private:
      * @brief Displays virtual memory statistics.
      */
     void VMStat();
+
+    /**
+     * @brief Compacts physical memory and reports how many pages were moved.
+     */
+    void compact();
+
+    /**
+     * @brief Saves processes, memory and scheduler queues to a checkpoint file.
+     * @param path The file to write.
+     * @param incremental Save only what changed since the last checkpoint.
+     */
+    void checkpoint(const std::string& path, bool incremental);
+
+    /**
+     * @brief Replaces the running system with a checkpoint file.
+     * @param path The file to read.
+     */
+    void restore(const std::string& path);
 };
\ No newline at end of file
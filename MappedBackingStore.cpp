@@ -0,0 +1,134 @@
+#include "MappedBackingStore.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Creates the swap file and maps the initial set of slots
+MappedBackingStore::MappedBackingStore(const std::string& filename, uint32_t pageSize, uint32_t initialSlots)
+    : BackingStore(pageSize), filename(filename) {
+    openHandle(true);
+    map(initialSlots > 0 ? initialSlots : 1);
+}
+
+// Syncs and unmaps the file
+MappedBackingStore::~MappedBackingStore() {
+    unmap();
+    closeHandle();
+}
+
+// Reopens the file and maps the slots it had when it was closed
+void MappedBackingStore::openFile() {
+    openHandle(false);
+    map(capacity);
+}
+
+void MappedBackingStore::closeFile() {
+    unmap();
+    closeHandle();
+}
+
+// Schedules all dirty mapped pages to be written back without waiting for the disk
+void MappedBackingStore::flushFile() {
+    if (!mapping) return;
+#ifdef _WIN32
+    FlushViewOfFile(mapping, 0);
+#else
+    msync(mapping, static_cast<size_t>(capacity) * pageSize, MS_ASYNC);
+#endif
+    unsyncedWrites = 0;
+}
+
+// Grows the file (doubling) and remaps it when a slot past the mapping is needed
+void MappedBackingStore::reserveSlots(uint32_t count) {
+    if (count <= capacity) return;
+
+    uint32_t newCapacity = capacity;
+    while (newCapacity < count) newCapacity *= 2;
+
+    unmap();
+    map(newCapacity);
+}
+
+void MappedBackingStore::readSlot(uint32_t slot, uint8_t* dest) {
+    std::memcpy(dest, mapping + static_cast<size_t>(slot) * pageSize, pageSize);
+}
+
+void MappedBackingStore::writeSlot(uint32_t slot, const uint8_t* src) {
+    std::memcpy(mapping + static_cast<size_t>(slot) * pageSize, src, pageSize);
+
+    // Batch syncs instead of syncing once per page-out
+    if (++unsyncedWrites >= SYNC_BATCH)
+        flushFile();
+}
+
+// Resizes the file to hold the given number of slots and maps all of it
+void MappedBackingStore::map(uint32_t slots) {
+    const size_t bytes = static_cast<size_t>(slots) * pageSize;
+
+#ifdef _WIN32
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE,
+                                       static_cast<DWORD>(static_cast<uint64_t>(bytes) >> 32),
+                                       static_cast<DWORD>(bytes & 0xFFFFFFFF), nullptr);
+    if (!mappingHandle)
+        throw std::runtime_error("Failed to map backing store \"" + filename + "\"");
+
+    mapping = static_cast<uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, bytes));
+    if (!mapping)
+        throw std::runtime_error("Failed to map backing store \"" + filename + "\"");
+#else
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+        throw std::runtime_error("Failed to grow backing store \"" + filename + "\"");
+
+    void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+        throw std::runtime_error("Failed to map backing store \"" + filename + "\"");
+    mapping = static_cast<uint8_t*>(addr);
+#endif
+
+    capacity = slots;
+}
+
+// Flushes and releases the current mapping
+void MappedBackingStore::unmap() {
+    if (!mapping) return;
+
+    flushFile();
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+    CloseHandle(mappingHandle);
+    mappingHandle = nullptr;
+#else
+    munmap(mapping, static_cast<size_t>(capacity) * pageSize);
+#endif
+    mapping = nullptr;
+}
+
+// Opens the swap file, discarding its contents if truncate is set
+void MappedBackingStore::openHandle(bool truncate) {
+#ifdef _WIN32
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                             truncate ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Failed to open backing store \"" + filename + "\"");
+#else
+    fd = ::open(filename.c_str(), truncate ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Failed to open backing store \"" + filename + "\"");
+#endif
+}
+
+void MappedBackingStore::closeHandle() {
+#ifdef _WIN32
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+
+#include "BackingStore.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ * @class MappedBackingStore
+ * @brief BackingStore whose slots live in a memory-mapped swap file.
+ *
+ * The file is preallocated with a number of slots and mapped into the address space,
+ * so a page-out is a memcpy from MemoryManager::memory into the mapping and a page-in
+ * is the reverse. No stream I/O happens on the page-fault path. Dirty mapped pages are
+ * pushed to disk in batches (every SYNC_BATCH slot writes, or on flush()) instead of
+ * once per page. When all slots are in use the file is grown and remapped at twice its size.
+ */
+class MappedBackingStore : public BackingStore {
+public:
+    /**
+     * @brief Creates (or truncates) and maps the swap file.
+     * @param filename     Path of the swap file.
+     * @param pageSize     Size of one page/slot in bytes.
+     * @param initialSlots Number of slots preallocated up front (the file holds one process's pages).
+     */
+    MappedBackingStore(const std::string& filename, uint32_t pageSize, uint32_t initialSlots = 16);
+    ~MappedBackingStore() override;
+
+protected:
+    void reserveSlots(uint32_t count) override;
+    void readSlot(uint32_t slot, uint8_t* dest) override;
+    void writeSlot(uint32_t slot, const uint8_t* src) override;
+    void openFile() override;
+    void closeFile() override;
+    void flushFile() override;
+
+private:
+    void openHandle(bool truncate);
+    void closeHandle();
+    void map(uint32_t slots);
+    void unmap();
+
+    static constexpr uint32_t SYNC_BATCH = 64;  // Slot writes between two asynchronous syncs
+
+    std::string filename;
+    uint8_t* mapping = nullptr;     // Start of the mapped file
+    uint32_t capacity = 0;          // Slots covered by the mapping
+    uint32_t unsyncedWrites = 0;    // Slot writes since the last sync
+
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
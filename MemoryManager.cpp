@@ -1,11 +1,13 @@
 #include "Process.h"
 #include "MemoryManager.h"
+#include "CheckpointStream.h"
 #include "ConsoleUtil.h"
+#include "Globals.h"
 
-#include <fstream>
+#include <algorithm>
 #include <iostream>
 #include <cstring>
-#include <filesystem>
+#include <stdexcept>
 
 std::shared_ptr<MemoryManager> MemoryManager::instance = nullptr;
 
@@ -16,8 +18,31 @@ MemoryManager::MemoryManager(const SystemConfig& config) {
     totalFrames = memorySize / frameSize;      // Calculate total number of frames
 
     frameTable.resize(totalFrames);            // Initialize frame table
+    changedFrames = std::vector<std::atomic<bool>>(totalFrames);
+
+    // Every frame starts out free, grouped into huge frames of HUGE_FRAME_PAGES frames
+    frameAllocator = FrameAllocator(totalFrames);
+    hugeFramesEnabled = config.hugeFrames == "on";
+    compactThreshold = static_cast<uint32_t>(config.compactThreshold);
     memory.resize(memorySize, 0);              // Initialize memory with zeros
-    std::filesystem::create_directory("backing_store"); // Ensure backing store directory exists
+    replacementPolicy = PageReplacementPolicy::create(config.pageReplacement, totalFrames);
+
+    // Swap space: one file per process under backing_store/, with one frameSize slot per
+    // stored page ("file" or memory-mapped "mmap")
+    backingStore = std::make_unique<SwapDirectory>(config.backingStore, "backing_store", frameSize);
+    swapIo = std::make_unique<SwapIoQueue>(*backingStore);
+
+    // Compressed pool in front of the backing store (disabled when its size is 0)
+    compressedCache = std::make_unique<CompressedPageCache>(frameSize, config.compressedPoolSize);
+
+    // Start the background write-back daemon
+    writeBackRunning = true;
+    writeBackThread = std::thread(&MemoryManager::writeBackLoop, this);
+}
+
+// Destructor: stops the write-back daemon and flushes whatever it still holds
+MemoryManager::~MemoryManager() {
+    shutdown();
 }
 
 // Static method to initialize the singleton instance
@@ -31,6 +56,11 @@ std::shared_ptr<MemoryManager> MemoryManager::getInstance() {
     return instance;
 }
 
+// Releases the singleton instance; it shuts down once its last user lets go of it
+void MemoryManager::destroy() {
+    instance.reset();
+}
+
 // Allocates a page table for the given process
 void MemoryManager::allocatePageTable(std::shared_ptr<Process> process) {
     // If process requires more memory than available, block it
@@ -44,11 +74,337 @@ void MemoryManager::allocatePageTable(std::shared_ptr<Process> process) {
     process->initPageTable(pageCount); // Initialize the page table with the calculated size
 }
 
+// Sets up the address space of a freshly created clone. Resident pages are shared: both page
+// tables map the same frame copy-on-write, so nothing is copied until one of them writes.
+// Saved pages are copied to the clone's own backing store slots in one batch, and
+// demand-zero pages stay demand-zero
+void MemoryManager::cloneAddressSpace(Process& source, Process& clone) {
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+
+    auto& sourceTable = source.getPageTable();
+    clone.initPageTable(static_cast<uint32_t>(sourceTable.size()));
+    auto& cloneTable = clone.getPageTable();
+    uint32_t clonePid = clone.getPID();
+
+    std::vector<uint32_t> savedVpns;
+    std::vector<std::vector<uint8_t>> savedPages;
+
+    // Regions the source never touched stay unallocated in the clone as well
+    sourceTable.forEachAllocated([&](uint32_t vpn, PageTableEntry& original) {
+        PageTableEntry& copy = cloneTable[vpn];
+
+        if (original.valid && original.sharedMemory) {
+            // Shared-memory segments stay shared with the clone rather than becoming copy-on-write
+            copy = original;
+            ++frameTable[original.frameNumber].refCount;
+            sharedMappings[clonePid].push_back(original.frameNumber);
+        } else if (original.valid) {
+            // Frames are shared one page at a time, so a huge frame mapping is split first
+            demoteHugeFrame(original.frameNumber);
+            frameTable[original.frameNumber].sharers.push_back(clonePid);
+            residentFrames[clonePid].insert(original.frameNumber);
+            original.copyOnWrite = true;
+            original.checkpointDirty = true;
+
+            copy.valid = true;
+            copy.frameNumber = original.frameNumber;
+            copy.copyOnWrite = true;
+            copy.zeroPage = original.zeroPage;
+            copy.referenced = original.referenced;
+            copy.referenceHistory = original.referenceHistory;
+            // The clone has nothing saved yet, so the page must be written out if evicted
+            // unless it is still an untouched demand-zero page
+            copy.dirty = original.dirty || !original.zeroPage;
+            ++pagesShared;
+        } else if (!original.zeroPage) {
+            std::vector<uint8_t> page(frameSize);
+            if (readStoredPage(source.getPID(), vpn, page.data())) {
+                copy.zeroPage = false;
+                savedVpns.push_back(vpn);
+                savedPages.push_back(std::move(page));
+            }
+        }
+    });
+
+    if (!savedPages.empty()) {
+        std::vector<SwapIoRequest> batch;
+        batch.reserve(savedPages.size());
+        for (size_t i = 0; i < savedPages.size(); ++i)
+            batch.push_back({ clonePid, savedVpns[i], savedPages[i].data(), true });
+        swapIo->submit(batch);
+    }
+}
+
+// SHM_OPEN: opens the named segment, creating it with enough zero-filled frames for the given
+// size if it does not exist yet (an existing segment keeps its size). Frames are taken from
+// the free list, evicting pages if needed, and are pinned until the segment is released
+SharedMemoryStatus MemoryManager::openSharedSegment(Process& process, const std::string& name, uint32_t bytes) {
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+
+    auto existing = sharedSegments.find(name);
+    if (existing != sharedSegments.end()) {
+        existing->second.openers.insert(process.getPID());
+        return SharedMemoryStatus::Ok;
+    }
+
+    uint32_t frameCount = (bytes + frameSize - 1) / frameSize;
+    if (frameCount == 0 || pinnedFrames + frameCount > totalFrames * SHM_MAX_PINNED_PERCENT / 100)
+        return SharedMemoryStatus::Invalid;
+
+    // Evict pages until the segment fits; only frames the replacement policy tracks can go. Frames
+    // being read in from swap are released only once memoryMutex is, so stop when only they are left
+    while (frameAllocator.getFreeCount() < frameCount && frameAllocator.getFreeCount() + pinnedFrames < totalFrames) {
+        if (!evictPage()) break;
+    }
+    if (frameAllocator.getFreeCount() < frameCount) {
+        blockOnMemory(process);
+        return SharedMemoryStatus::NoMemory;
+    }
+
+    SharedSegment& segment = sharedSegments[name];
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        uint32_t frameNumber = *allocateFrame();
+        std::fill_n(memory.begin() + frameNumber * frameSize, frameSize, 0);
+
+        frameTable[frameNumber].inUse = true;
+        frameTable[frameNumber].pfid = -1;
+        frameTable[frameNumber].virtualPageNumber = i;
+        frameTable[frameNumber].refCount = 0;
+        segment.frames.push_back(frameNumber);
+    }
+    segment.openers.insert(process.getPID());
+    pinnedFrames += frameCount;
+    return SharedMemoryStatus::Ok;
+}
+
+// SHM_ATTACH: maps every frame of the named segment into the process's page table starting at
+// the given page-aligned virtual address. Whatever those pages held before is discarded
+SharedMemoryStatus MemoryManager::attachSharedSegment(Process& process, const std::string& name, uint32_t virtualAddress) {
+    std::vector<std::shared_ptr<Process>> woken;
+    {
+        std::unique_lock<std::shared_mutex> lock(memoryMutex);
+
+        auto segment = sharedSegments.find(name);
+        if (segment == sharedSegments.end())
+            return SharedMemoryStatus::NoSegment;
+
+        auto& pageTable = process.getPageTable();
+        const std::vector<uint32_t>& frames = segment->second.frames;
+        uint32_t firstVpn = virtualAddress / frameSize;
+        if (virtualAddress % frameSize != 0 || firstVpn + frames.size() > pageTable.size())
+            return SharedMemoryStatus::Invalid;
+
+        uint32_t pid = process.getPID();
+        for (uint32_t i = 0; i < frames.size(); ++i) {
+            uint32_t vpn = firstVpn + i;
+            discardMapping(process, vpn);
+
+            PageTableEntry& entry = pageTable[vpn];
+            entry.valid = true;
+            entry.sharedMemory = true;
+            entry.zeroPage = false;
+            entry.referenced = true;
+            entry.frameNumber = frames[i];
+            entry.checkpointDirty = true;
+            ++frameTable[frames[i]].refCount;
+            sharedMappings[pid].push_back(frames[i]);
+        }
+
+        // Pages mapped over may have freed frames or left another segment unused
+        releaseUnusedSharedSegments();
+        woken = wakeMemoryWaiters();
+    }
+
+    if (auto scheduler = GlobalScheduler::getInstance()) {
+        for (auto& process : woken)
+            scheduler->requeueProcess(process);
+    }
+    return SharedMemoryStatus::Ok;
+}
+
+// Empties a page of the process before a segment is mapped over it: its frame (private,
+// copy-on-write or another segment's), any saved copies, and its TLB entries
+// (caller holds memoryMutex exclusively)
+void MemoryManager::discardMapping(Process& process, uint32_t vpn) {
+    uint32_t pid = process.getPID();
+    PageTableEntry& entry = process.getPageTable()[vpn];
+
+    if (entry.valid) {
+        uint32_t frameNumber = entry.frameNumber;
+        shootDownTLBs(pid, vpn);
+
+        if (entry.sharedMemory) {
+            unmapSharedFrame(pid, frameNumber);
+        } else {
+            demoteHugeFrame(frameNumber);
+            removeResidentFrame(pid, frameNumber);
+            if (!frameTable[frameNumber].sharers.empty()) {
+                detachSharer(frameNumber, pid);
+            } else {
+                replacementPolicy->onFrameFreed(frameNumber);
+                releaseFrame(frameNumber);
+            }
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(writeBackMutex);
+        eraseQueuedWriteBack(pid, vpn, lock);
+    }
+    backingStore->discardPage(pid, vpn);
+    compressedCache->invalidate(pid, vpn);
+    entry = PageTableEntry{};
+    entry.checkpointDirty = true;
+}
+
+// Drops one mapping of a segment frame by a process (caller holds memoryMutex exclusively)
+void MemoryManager::unmapSharedFrame(uint32_t pid, uint32_t frameNumber) {
+    --frameTable[frameNumber].refCount;
+
+    auto mappings = sharedMappings.find(pid);
+    if (mappings == sharedMappings.end()) return;
+
+    auto mapping = std::find(mappings->second.begin(), mappings->second.end(), frameNumber);
+    if (mapping != mappings->second.end())
+        mappings->second.erase(mapping);
+    if (mappings->second.empty())
+        sharedMappings.erase(mappings);
+}
+
+// Frees the frames of segments that no process has open or mapped (caller holds memoryMutex exclusively)
+void MemoryManager::releaseUnusedSharedSegments() {
+    for (auto it = sharedSegments.begin(); it != sharedSegments.end();) {
+        const SharedSegment& segment = it->second;
+        bool mapped = std::any_of(segment.frames.begin(), segment.frames.end(),
+                                  [this](uint32_t frameNumber) { return frameTable[frameNumber].refCount > 0; });
+        if (!segment.openers.empty() || mapped) {
+            ++it;
+            continue;
+        }
+
+        for (uint32_t frameNumber : segment.frames) {
+            releaseFrame(frameNumber);
+            frameTable[frameNumber].pfid = -1;
+            frameTable[frameNumber].virtualPageNumber = -1;
+        }
+        pinnedFrames -= static_cast<uint32_t>(segment.frames.size());
+        it = sharedSegments.erase(it);
+    }
+}
+
+size_t MemoryManager::getSharedSegmentCount() const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    return sharedSegments.size();
+}
+
+uint32_t MemoryManager::getPinnedFrameCount() const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    return pinnedFrames;
+}
+
 // Handles memory access for a process at a given virtual address, with optional write flag
-std::optional<uint32_t> MemoryManager::accessMemory(std::shared_ptr<Process> process, uint32_t virtualAddress, bool write) {
+std::optional<uint32_t> MemoryManager::accessMemory(Process& process, uint32_t virtualAddress, bool write) {
+    {
+        std::shared_lock<std::shared_mutex> lock(memoryMutex);
+        if (auto physicalAddress = translateResident(process, virtualAddress, write))
+            return physicalAddress;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+    return translateAddress(process, virtualAddress, write, lock);
+}
+
+// Translates and reads a 16-bit value in one step, so the page cannot be evicted
+// or cleaned by the write-back daemon between translation and access.
+// Resident pages are served under the shared lock; only a page fault takes it exclusively.
+std::optional<uint16_t> MemoryManager::readVirtual(Process& process, uint32_t virtualAddress) {
+    {
+        std::shared_lock<std::shared_mutex> lock(memoryMutex);
+        if (auto physicalAddress = translateResident(process, virtualAddress, false))
+            return readUint16At(*physicalAddress);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+    auto physicalAddress = translateAddress(process, virtualAddress, false, lock);
+    if (!physicalAddress.has_value()) return std::nullopt;
+    return readUint16At(physicalAddress.value());
+}
+
+// Translates and writes a 16-bit value in one step (see readVirtual)
+bool MemoryManager::writeVirtual(Process& process, uint32_t virtualAddress, uint16_t value) {
+    {
+        std::shared_lock<std::shared_mutex> lock(memoryMutex);
+        if (auto physicalAddress = translateResident(process, virtualAddress, true)) {
+            writeUint16At(*physicalAddress, value);
+            return true;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+    auto physicalAddress = translateAddress(process, virtualAddress, true, lock);
+    if (!physicalAddress.has_value()) return false;
+    writeUint16At(physicalAddress.value(), value);
+    return true;
+}
+
+// Resolves a virtual address whose page is already resident, or returns std::nullopt so the
+// caller retries with translateAddress (caller holds memoryMutex, shared is enough).
+// Only the thread running the process touches its PTE bits and its core's TLB under the
+// shared lock; everything else that changes them holds memoryMutex exclusively.
+std::optional<uint32_t> MemoryManager::translateResident(Process& process, uint32_t virtualAddress, bool write) {
+    if (static_cast<uint64_t>(virtualAddress) + 1 >= process.getMemoryRequired())
+        return std::nullopt;
+
+    uint32_t vpn = virtualAddress / frameSize;
+    uint32_t offset = virtualAddress % frameSize;
+
+    // A TLB hit skips the page-table walk entirely
+    TLB* tlb = tlbFor(process);
+    if (tlb) {
+        if (TLB::Entry* cached = tlb->lookup(process.getPID(), vpn)) {
+            // A write to a copy-on-write page needs a private frame first
+            if (write && cached->pte->copyOnWrite)
+                return std::nullopt;
+            ++tlbHits;
+            if (write) cached->pte->dirty = true;
+            cached->pte->referenced = true;
+            cached->pte->wsReferenced = true;
+            replacementPolicy->onPageAccessed(trackedFrame(cached->frameNumber));
+            return cached->frameNumber * frameSize + offset;
+        }
+        ++tlbMisses;
+    }
+
+    // Look the entry up without allocating: an untouched region is never resident
+    PageTableEntry* found = process.getPageTable().find(vpn);
+    if (!found || !found->valid)
+        return std::nullopt;
+
+    // The first access to a read-ahead page updates the prefetch window, and a write to a
+    // copy-on-write page copies its frame; both need the exclusive lock
+    if (found->prefetched || (write && found->copyOnWrite))
+        return std::nullopt;
+
+    PageTableEntry& entry = *found;
+    if (write) entry.dirty = true;
+    entry.referenced = true;
+    entry.wsReferenced = true;
+    replacementPolicy->onPageAccessed(trackedFrame(entry.frameNumber));
+    if (tlb) tlb->insert(process.getPID(), vpn, entry.frameNumber, &entry);
+
+    return entry.frameNumber * frameSize + offset;
+}
+
+// Resolves a virtual address to a physical one, faulting the page in if needed (caller holds
+// memoryMutex exclusively through lock; it is released while swap reads are in progress).
+// Every std::nullopt leaves the process either Blocked in the memory wait queue or Terminated,
+// so the caller never has to change its state afterwards
+std::optional<uint32_t> MemoryManager::translateAddress(Process& process, uint32_t virtualAddress, bool write,
+                                                        std::unique_lock<std::shared_mutex>& lock) {
     // Check if the virtual address is within the process's memory bounds
-    if (virtualAddress + 1 >= process->getMemoryRequired()) {
-        ConsoleUtil::logError("Memory access out of process bounds. PID: " + std::to_string(process->getPID()));
+    if (static_cast<uint64_t>(virtualAddress) + 1 >= process.getMemoryRequired()) {
+        ConsoleUtil::logError("Memory access out of process bounds. PID: " + std::to_string(process.getPID()));
+        terminateOnViolation(process, virtualAddress);
         return std::nullopt;
     }
 
@@ -56,79 +412,426 @@ std::optional<uint32_t> MemoryManager::accessMemory(std::shared_ptr<Process> pro
     uint32_t vpn = virtualAddress / frameSize;
     uint32_t offset = virtualAddress % frameSize;
 
-    auto& pageTable = process->getPageTable();
+    TLB* tlb = tlbFor(process);
+    auto& pageTable = process.getPageTable();
 
     // Check if the vpn is valid for this process
-    if (vpn >= pageTable.size())
+    if (vpn >= pageTable.size()) {
+        terminateOnViolation(process, virtualAddress);
         return std::nullopt;
+    }
 
     PageTableEntry& entry = pageTable[vpn];
 
+    // A write to a frame shared with a clone gets a private copy first. If the shared frame
+    // was evicted to make room for the copy, the page is faulted in below like any other
+    if (entry.valid && write && entry.copyOnWrite && !breakCopyOnWrite(process, vpn)) {
+        blockOnMemory(process);
+        return std::nullopt;
+    }
+
     // If the page is not currently loaded (not valid)
     if (!entry.valid) {
-        // Count how many frames this process currently owns
-        size_t framesOwned = 0;
-        for (const auto& frame : frameTable) {
-            if (frame.inUse && frame.pfid == process->getPID()) {
-                ++framesOwned;
-            }
-        }
+        // Number of frames this process currently owns
+        size_t framesOwned = residentCount(process.getPID());
 
-        // Calculate the maximum number of frames this process is allowed
-        size_t maxAllowedFrames = process->getMemoryRequired() / frameSize;
-        // If the process already owns the max allowed frames or not enough frames in system, block it
-        if (framesOwned >= maxAllowedFrames || totalFrames < maxAllowedFrames) {
-            process->setState(ProcessState::Blocked);
+        // A process never holds more frames than it has pages; block it if even that cannot fit
+        size_t maxAllowedFrames = pageTable.size();
+        if (totalFrames < maxAllowedFrames) {
+            blockOnMemory(process);
             return std::nullopt;
         }
 
-        // Try to find a free frame
-        int frameNumber = findFreeFrame();
-        if (frameNumber == -1) {
-            // If no free frame, evict a page using FIFO
-            evictPage();
-            frameNumber = findFreeFrame();
+        // Admission control: a process with nothing resident only gets in if its working set fits
+        if (framesOwned == 0 && !admitProcess(process)) {
+            ++admissionsDenied;
+            blockOnMemory(process);
+            return std::nullopt;
         }
 
-        // If still no free frame, block the process
-        if (frameNumber == -1) {
-            process->setState(ProcessState::Blocked);
-            return std::nullopt;
+        // A whole huge frame, if one is free, takes the page and its aligned neighbours at once
+        if (hugeFramesEnabled && mapHugeFrame(process, vpn)) {
+            ++hugePageFaults;
+        } else {
+            // At its allowance, the process replaces one of its own pages
+            if (framesOwned >= maxAllowedFrames)
+                evictOwnPage(process);
+
+            // Try to take a free frame
+            std::optional<uint32_t> frameNumber = allocateFrame();
+            if (!frameNumber) {
+                // Over its working-set quota the process replaces its own pages; otherwise
+                // the page chosen by the global replacement policy is evicted
+                if (framesOwned >= frameQuota(process))
+                    evictOwnPage(process);
+                else
+                    evictPage();
+                frameNumber = allocateFrame();
+            }
+
+            // If still no free frame, block the process
+            if (!frameNumber) {
+                blockOnMemory(process);
+                return std::nullopt;
+            }
+
+            // Load the required page into the allocated frame
+            loadPage(process, vpn, *frameNumber);
+
+            // Sequential faults pull the next pages in ahead of time
+            readAheadAfterFault(process, vpn);
         }
 
-        // Load the required page into the found frame
-        loadPage(process, vpn, frameNumber);
-        tryUnblockingBlockedProcesses(); // Try to unblock any processes that may now have enough memory
+        // The swap reads of the page and of its read-ahead or huge frame neighbours go out together
+        submitSwapReads(lock);
+        ++pageFaults;
+    }
+    else if (entry.prefetched) {
+        // A read-ahead page is being used: count the hit and widen the window
+        entry.prefetched = false;
+        ++prefetchHits;
+        ReadAheadState& state = readAheadStates[process.getPID()];
+        state.window = std::min(state.window * 2, READAHEAD_MAX_WINDOW);
     }
 
     // Update the page table entry if this is a write operation
     PageTableEntry& updatedEntry = pageTable[vpn];
     if (write) updatedEntry.dirty = true;
+    updatedEntry.referenced = true;
+    updatedEntry.wsReferenced = true;
+    replacementPolicy->onPageAccessed(trackedFrame(updatedEntry.frameNumber));
+    if (tlb) tlb->insert(process.getPID(), vpn, updatedEntry.frameNumber, &updatedEntry);
 
     // Return the physical address corresponding to the virtual address
     return updatedEntry.frameNumber * frameSize + offset;
 }
 
-// Finds and returns the index of a free frame, or -1 if none are available
-int MemoryManager::findFreeFrame() {
-    for (size_t i = 0; i < frameTable.size(); ++i) {
-        if (!frameTable[i].inUse)
-            return static_cast<int>(i);
+// Takes a free base frame, or returns std::nullopt if none are available
+std::optional<uint32_t> MemoryManager::allocateFrame() {
+    std::optional<uint32_t> frameNumber = frameAllocator.allocate();
+    if (frameNumber) changedFrames[*frameNumber] = true;
+    return frameNumber;
+}
+
+// Maps the aligned group of HUGE_FRAME_PAGES pages around vpn into a whole free huge frame,
+// loading every page of the group in this one fault. The replacement policy tracks only the
+// first frame, so the group costs one queue entry and is evicted together. Returns false
+// without mapping anything if the group does not lie inside the process, one of its pages is
+// already resident, or no huge frame is free (caller holds memoryMutex exclusively)
+bool MemoryManager::mapHugeFrame(Process& process, uint32_t vpn) {
+    auto& pageTable = process.getPageTable();
+    uint32_t firstVpn = vpn - vpn % HUGE_FRAME_PAGES;
+    if (static_cast<uint64_t>(firstVpn) + HUGE_FRAME_PAGES > pageTable.size())
+        return false;
+
+    for (uint32_t i = 0; i < HUGE_FRAME_PAGES; ++i) {
+        if (pageTable[firstVpn + i].valid) return false;
+    }
+
+    std::optional<uint32_t> firstFrame = frameAllocator.allocateHuge();
+    if (!firstFrame) return false;
+
+    for (uint32_t i = 0; i < HUGE_FRAME_PAGES; ++i) {
+        changedFrames[*firstFrame + i] = true;
+        frameTable[*firstFrame + i].huge = true;
+        loadPage(process, firstVpn + i, *firstFrame + i);
+
+        // Only the faulting page has been accessed
+        pageTable[firstVpn + i].referenced = firstVpn + i == vpn;
+    }
+    replacementPolicy->onPageLoaded(*firstFrame);
+    return true;
+}
+
+// Splits a huge frame mapping into independent base frames, each tracked by the replacement
+// policy, before one of its pages is shared, discarded or replaced on its own
+// (caller holds memoryMutex exclusively)
+void MemoryManager::demoteHugeFrame(uint32_t frameNumber) {
+    if (!frameTable[frameNumber].huge) return;
+
+    uint32_t firstFrame = frameNumber - frameNumber % HUGE_FRAME_PAGES;
+    for (uint32_t i = 0; i < HUGE_FRAME_PAGES; ++i) {
+        frameTable[firstFrame + i].huge = false;
+        if (i > 0) replacementPolicy->onPageLoaded(firstFrame + i);
+    }
+}
+
+// The frame the replacement policy tracks for a page: the first frame of its huge frame
+// mapping, or the frame itself (caller holds memoryMutex)
+uint32_t MemoryManager::trackedFrame(uint32_t frameNumber) const {
+    return frameTable[frameNumber].huge ? frameNumber - frameNumber % HUGE_FRAME_PAGES : frameNumber;
+}
+
+// Number of frames that leave memory together with a frame the replacement policy tracks
+uint32_t MemoryManager::mappedFrameCount(uint32_t frameNumber) const {
+    return frameTable[frameNumber].huge ? HUGE_FRAME_PAGES : 1;
+}
+
+// "compact" command: compacts physical memory now. Returns the number of pages moved
+uint32_t MemoryManager::compactMemory() {
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+    return compactFrames();
+}
+
+// Called once per scheduler tick: compacts physical memory if fragmentation is above the
+// compact-threshold set in config.txt
+void MemoryManager::compactIfFragmented() {
+    if (compactThreshold == 0) return;
+
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+    if (fragmentation() > compactThreshold)
+        compactFrames();
+}
+
+double MemoryManager::getFragmentation() const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    return fragmentation();
+}
+
+// Share (percent) of the huge frames the free frames could fill that are not whole, because
+// their free frames are scattered between resident pages (caller holds memoryMutex)
+double MemoryManager::fragmentation() const {
+    uint32_t possible = std::min(frameAllocator.getFreeCount() / HUGE_FRAME_PAGES, frameAllocator.getHugeFrameCount());
+    if (possible == 0) return 0.0;
+
+    uint32_t whole = std::min(frameAllocator.getFreeHugeCount(), possible);
+    return 100.0 * (possible - whole) / possible;
+}
+
+// Two-finger compaction: the lowest free frame receives the page in the highest movable
+// frame until the two meet, so resident pages end up packed at the bottom of memory and
+// free frames coalesce into whole huge frames at the top. Runs under the exclusive lock,
+// so no core observes a page mid-move (caller holds memoryMutex exclusively)
+uint32_t MemoryManager::compactFrames() {
+    uint32_t moved = 0;
+    uint32_t target = 0;
+    uint32_t source = totalFrames;
+
+    while (true) {
+        while (target < source && !frameAllocator.isFree(target)) ++target;
+        while (source > target && !isMovableFrame(source - 1)) --source;
+        if (source <= target) break;
+
+        migrateFrame(source - 1, target);
+        --source;
+        ++moved;
     }
-    return -1;
+
+    ++compactions;
+    pagesMigrated += moved;
+    return moved;
+}
+
+// A frame can be moved if it holds a process page. Shared-memory segment frames and frames
+// being read in from swap stay put, and huge frame mappings are already contiguous
+// (caller holds memoryMutex)
+bool MemoryManager::isMovableFrame(uint32_t frameNumber) const {
+    const PageFrame& frame = frameTable[frameNumber];
+    return frame.inUse && frame.pfid >= 0 && !frame.huge && frame.refCount == 0 && !frame.pagingIn;
+}
+
+// Moves the page held in one frame to a free frame: copies the data, then repoints the page
+// table entries and resident sets of every process mapping it (the owner and any copy-on-write
+// clones) and the replacement policy's entry. Cached translations are shot down
+// (caller holds memoryMutex exclusively)
+void MemoryManager::migrateFrame(uint32_t from, uint32_t to) {
+    frameAllocator.take(to);
+    changedFrames[to] = true;
+    std::copy_n(memory.begin() + from * frameSize, frameSize, memory.begin() + to * frameSize);
+
+    PageFrame& source = frameTable[from];
+    PageFrame& target = frameTable[to];
+    target.inUse = true;
+    target.pfid = source.pfid;
+    target.virtualPageNumber = source.virtualPageNumber;
+    target.sharers = std::move(source.sharers);
+    source.sharers.clear();
+
+    uint32_t vpn = target.virtualPageNumber;
+    std::vector<uint32_t> mappers{ static_cast<uint32_t>(target.pfid) };
+    mappers.insert(mappers.end(), target.sharers.begin(), target.sharers.end());
+    for (uint32_t pid : mappers) {
+        auto resident = residentFrames.find(pid);
+        if (resident != residentFrames.end()) {
+            resident->second.erase(from);
+            resident->second.insert(to);
+        }
+
+        if (auto process = Process::getProcessByPID(pid)) {
+            if (PageTableEntry* entry = process->getPageTable().find(vpn)) {
+                entry->frameNumber = to;
+                entry->checkpointDirty = true;
+            }
+        }
+        shootDownTLBs(pid, vpn);
+    }
+
+    replacementPolicy->onFrameMoved(from, to);
+    releaseFrame(from);
+    source.pfid = -1;
+    source.virtualPageNumber = -1;
+}
+
+// Returns the number of frames holding pages of the process (caller holds memoryMutex)
+size_t MemoryManager::residentCount(uint32_t pid) const {
+    auto it = residentFrames.find(pid);
+    return it == residentFrames.end() ? 0 : it->second.size();
+}
+
+// Removes a frame from a process's resident set (caller holds memoryMutex)
+void MemoryManager::removeResidentFrame(uint32_t pid, uint32_t frameNumber) {
+    auto it = residentFrames.find(pid);
+    if (it == residentFrames.end()) return;
+
+    it->second.erase(frameNumber);
+    if (it->second.empty())
+        residentFrames.erase(it);
+}
+
+uint32_t MemoryManager::getResidentFrameCount(uint32_t pid) const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    return static_cast<uint32_t>(residentCount(pid));
+}
+
+uint32_t MemoryManager::getFreeFrameCount() const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    return frameAllocator.getFreeCount();
 }
 
-// Evicts a page from memory using FIFO page replacement
-void MemoryManager::evictPage() {
-    if (fifoQueue.empty()) {
-        std::cerr << "[X] FIFO queue is empty. Cannot evict any pages.\n";
+uint32_t MemoryManager::getFreeHugeFrameCount() const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    return frameAllocator.getFreeHugeCount();
+}
+
+// Marks a frame as free and hands it back to the allocator
+void MemoryManager::releaseFrame(uint32_t frameNumber) {
+    frameTable[frameNumber].inUse = false;
+    frameTable[frameNumber].huge = false;
+    frameAllocator.release(frameNumber);
+}
+
+// Evicts the page chosen by the configured page replacement policy. Returns false if nothing
+// was evicted: no page is resident, or every candidate is still being read in from swap
+bool MemoryManager::evictPage() {
+    // Reads and clears the referenced bit of the page held in a frame (for a frame shared
+    // copy-on-write, of every process mapping it; for a huge frame, of every page in it)
+    auto testAndClearReferenced = [this](uint32_t frameNumber) {
+        bool referenced = false;
+
+        for (uint32_t i = 0; i < mappedFrameCount(frameNumber); ++i) {
+            const PageFrame& frame = frameTable[frameNumber + i];
+
+            auto testAndClear = [&](uint32_t pid) {
+                std::shared_ptr<Process> owner = Process::getProcessByPID(pid);
+                if (!owner || frame.virtualPageNumber >= owner->getPageTable().size()) return;
+
+                PageTableEntry& entry = owner->getPageTable()[frame.virtualPageNumber];
+                if (entry.referenced) referenced = true;
+                entry.referenced = false;
+            };
+
+            testAndClear(frame.pfid);
+            for (uint32_t pid : frame.sharers)
+                testAndClear(pid);
+        }
+        return referenced;
+    };
+
+    // A frame still being read in from swap cannot go: pass over it, then hand it back to the policy
+    std::vector<uint32_t> skipped;
+    std::optional<uint32_t> victim;
+    while ((victim = replacementPolicy->selectVictim(testAndClearReferenced)) && isPagingIn(*victim))
+        skipped.push_back(*victim);
+    for (uint32_t frameNumber : skipped)
+        replacementPolicy->onPageLoaded(frameNumber);
+
+    if (!victim) {
+        if (skipped.empty())
+            std::cerr << "[X] No resident pages. Cannot evict any pages.\n";
+        return false;
+    }
+
+    evictFrame(*victim);
+    return true;
+}
+
+// True if a page leaving with the frame is still being read in from swap (caller holds memoryMutex)
+bool MemoryManager::isPagingIn(uint32_t frameNumber) const {
+    for (uint32_t i = 0; i < mappedFrameCount(frameNumber); ++i) {
+        if (frameTable[frameNumber + i].pagingIn) return true;
+    }
+    return false;
+}
+
+// Evicts the page of a process whose reference history is oldest (local replacement).
+// Private frames are preferred; a frame shared copy-on-write stays resident for the other
+// processes and only this process's mapping of it is dropped (caller holds memoryMutex exclusively)
+void MemoryManager::evictOwnPage(Process& process) {
+    uint32_t pid = process.getPID();
+    auto resident = residentFrames.find(pid);
+    if (resident == residentFrames.end()) return;
+
+    auto& pageTable = process.getPageTable();
+    std::optional<uint32_t> victim;
+    std::pair<bool, uint8_t> victimKey;     // (shared, reference history)
+    for (uint32_t frameNumber : resident->second) {
+        const PageTableEntry& entry = pageTable[frameTable[frameNumber].virtualPageNumber];
+        std::pair<bool, uint8_t> key(!frameTable[frameNumber].sharers.empty(),
+                                     static_cast<uint8_t>(entry.referenceHistory | (entry.wsReferenced ? 0x80 : 0)));
+        if (!victim || key < victimKey) {
+            victim = frameNumber;
+            victimKey = key;
+        }
+    }
+
+    // Only the chosen page goes, not the rest of its huge frame
+    demoteHugeFrame(*victim);
+
+    if (victimKey.first) {
+        uint32_t vpn = frameTable[*victim].virtualPageNumber;
+        detachSharer(*victim, pid);
+        removeResidentFrame(pid, *victim);
+        shootDownTLBs(pid, vpn);
+        unmapPage(pid, vpn);
+    } else {
+        replacementPolicy->onFrameFreed(*victim);
+        evictFrame(*victim);
+    }
+    ++localReplacements;
+}
+
+// Writes back (if needed) and unmaps the page held in a frame the replacement policy no longer tracks
+// (caller holds memoryMutex exclusively)
+void MemoryManager::evictFrame(uint32_t frameNumber) {
+    // A huge frame mapping leaves memory as a whole, one base page at a time
+    if (frameTable[frameNumber].huge) {
+        uint32_t firstFrame = frameNumber - frameNumber % HUGE_FRAME_PAGES;
+        for (uint32_t i = 0; i < HUGE_FRAME_PAGES; ++i)
+            frameTable[firstFrame + i].huge = false;
+        for (uint32_t i = 0; i < HUGE_FRAME_PAGES; ++i)
+            evictFrame(firstFrame + i);
         return;
     }
 
-    // Get the oldest page (front of the queue)
-    auto [pid, vpn] = fifoQueue.front();
-    fifoQueue.pop_front();
+    uint32_t vpn = frameTable[frameNumber].virtualPageNumber;
+
+    // Every process mapping the frame loses the page: the owner and any copy-on-write clones
+    std::vector<uint32_t> mappers{ static_cast<uint32_t>(frameTable[frameNumber].pfid) };
+    mappers.insert(mappers.end(), frameTable[frameNumber].sharers.begin(), frameTable[frameNumber].sharers.end());
+    frameTable[frameNumber].sharers.clear();
 
+    // Return the frame to the free-frame stack and drop it from the resident sets
+    releaseFrame(frameNumber);
+    for (uint32_t pid : mappers) {
+        removeResidentFrame(pid, frameNumber);
+        shootDownTLBs(pid, vpn);
+        unmapPage(pid, vpn);
+    }
+}
+
+// Invalidates one process's mapping of a page leaving its frame, saving the contents first
+// if they are dirty. The frame still holds the data (caller holds memoryMutex exclusively)
+void MemoryManager::unmapPage(uint32_t pid, uint32_t vpn) {
     // Get the process by PID
     std::shared_ptr<Process> process = Process::getProcessByPID(pid);
     if (!process) return;
@@ -140,127 +843,594 @@ void MemoryManager::evictPage() {
 
     // If the page is valid (present in memory)
     if (entry.valid) {
-        // If the page is dirty, save it to backing store before eviction
-        if (entry.dirty) {
-            savePageToBackingStore(pid, vpn, entry.frameNumber);
-            ++pagesPagedOut;
+        // A read-ahead page evicted before it was ever used was a wasted read: shrink the window
+        if (entry.prefetched) {
+            entry.prefetched = false;
+            ++prefetchMisses;
+            ReadAheadState& state = readAheadStates[pid];
+            state.window = std::max(state.window / 2, READAHEAD_MIN_WINDOW);
         }
-        // Mark the frame as free and invalidate the page table entry
-        frameTable[entry.frameNumber].inUse = false;
+
+        // Dirty pages go, in order of preference: nowhere (all zeros), the compressed pool,
+        // the write-back queue, or a batched write together with the full queue
+        if (entry.dirty && !dropIfZeroPage(pid, vpn, entry) &&
+            !compressToPool(pid, vpn, entry.frameNumber) && !enqueueWriteBack(pid, vpn, entry.frameNumber)) {
+            writeBackWithQueue(pid, vpn, entry.frameNumber);
+            ++syncWriteBacks;
+        }
+        // Invalidate the page table entry
         entry.valid = false;
+        entry.copyOnWrite = false;
+        entry.checkpointDirty = true;
+    }
+}
+
+// Removes one process's mapping from a shared frame; the frame stays with the other mappings.
+// The last mapping left is no longer copy-on-write (caller holds memoryMutex exclusively)
+void MemoryManager::detachSharer(uint32_t frameNumber, uint32_t pid) {
+    PageFrame& frame = frameTable[frameNumber];
+    if (frame.pfid == static_cast<int>(pid)) {
+        frame.pfid = static_cast<int>(frame.sharers.back());
+        frame.sharers.pop_back();
+    } else {
+        frame.sharers.erase(std::remove(frame.sharers.begin(), frame.sharers.end(), pid), frame.sharers.end());
+    }
+
+    if (frame.sharers.empty()) {
+        if (auto owner = Process::getProcessByPID(frame.pfid)) {
+            auto& pageTable = owner->getPageTable();
+            if (frame.virtualPageNumber < pageTable.size()) {
+                pageTable[frame.virtualPageNumber].copyOnWrite = false;
+                pageTable[frame.virtualPageNumber].checkpointDirty = true;
+            }
+        }
+    }
+}
+
+// Gives a process its own copy of a frame it shares copy-on-write, before its first write.
+// Returns false if no frame could be found for the copy (caller holds memoryMutex exclusively)
+bool MemoryManager::breakCopyOnWrite(Process& process, uint32_t vpn) {
+    uint32_t pid = process.getPID();
+    PageTableEntry& entry = process.getPageTable()[vpn];
+    uint32_t sharedFrame = entry.frameNumber;
+
+    // Every other mapping is gone, so the frame is already private
+    if (frameTable[sharedFrame].sharers.empty()) {
+        entry.copyOnWrite = false;
+        entry.checkpointDirty = true;
+        return true;
+    }
+
+    std::optional<uint32_t> frameNumber = allocateFrame();
+    if (!frameNumber) {
+        evictPage();
+
+        // The shared frame itself may have been the victim; the caller then faults the page in
+        if (!entry.valid) return true;
+
+        frameNumber = allocateFrame();
+        if (!frameNumber) return false;
     }
+
+    std::copy_n(memory.begin() + sharedFrame * frameSize, frameSize, memory.begin() + *frameNumber * frameSize);
+
+    // Move this process's mapping from the shared frame to the copy
+    detachSharer(sharedFrame, pid);
+    removeResidentFrame(pid, sharedFrame);
+    shootDownTLBs(pid, vpn);
+
+    frameTable[*frameNumber].inUse = true;
+    frameTable[*frameNumber].pfid = pid;
+    frameTable[*frameNumber].virtualPageNumber = vpn;
+    residentFrames[pid].insert(*frameNumber);
+    replacementPolicy->onPageLoaded(*frameNumber);
+
+    entry.frameNumber = *frameNumber;
+    entry.copyOnWrite = false;
+    entry.checkpointDirty = true;
+    ++copyOnWriteFaults;
+    return true;
+}
+
+// Working-set quota: the pages referenced in the sampling window plus one page of slack,
+// at least one frame and at most one frame per page (caller holds memoryMutex)
+size_t MemoryManager::frameQuota(Process& process) const {
+    auto it = workingSetSizes.find(process.getPID());
+    size_t workingSet = it == workingSetSizes.end() ? WS_INITIAL_ESTIMATE : it->second;
+    return std::clamp<size_t>(workingSet + WS_QUOTA_SLACK, 1, std::max<size_t>(process.getPageTable().size(), 1));
+}
+
+// Frames a process with nothing resident is expected to need: its last working set, or
+// WS_INITIAL_ESTIMATE if it has none yet, capped at its page count (caller holds memoryMutex)
+size_t MemoryManager::admissionEstimate(Process& process) const {
+    return std::min<size_t>(frameQuota(process) - WS_QUOTA_SLACK, process.getPageTable().size());
+}
+
+// Lets a process with no resident pages in only if the working sets of the resident processes
+// plus its own still fit in physical memory. The first process is always admitted so a single
+// large process cannot be locked out (caller holds memoryMutex exclusively)
+bool MemoryManager::admitProcess(Process& process) {
+    size_t estimate = admissionEstimate(process);
+    if (totalWorkingSet > 0 && totalWorkingSet + estimate > totalFrames)
+        return false;
+
+    // Count the admission right away so several processes admitted within one tick add up
+    totalWorkingSet += std::max<size_t>(estimate, 1);
+    return true;
+}
+
+// Called once per scheduler tick: shifts every page's referenced-this-tick bit into its
+// reference history and recomputes each process's working set, i.e. the pages referenced
+// during the last WS_WINDOW_TICKS ticks. Working sets shrink as pages age out, so waiters
+// that admission control turned away are woken once their working set fits again
+void MemoryManager::sampleWorkingSets() {
+    std::vector<std::shared_ptr<Process>> woken;
+    {
+        std::unique_lock<std::shared_mutex> lock(memoryMutex);
+        recomputeWorkingSets();
+        woken = wakeMemoryWaiters();
+    }
+
+    // Requeued outside memoryMutex, as in freeProcessPages
+    if (auto scheduler = GlobalScheduler::getInstance()) {
+        for (auto& process : woken)
+            scheduler->requeueProcess(process);
+    }
+}
+
+// Recomputes every working set and their total (caller holds memoryMutex exclusively)
+void MemoryManager::recomputeWorkingSets() {
+    size_t total = 0;
+    for (auto& process : Process::getRegisteredProcesses()) {
+        auto& pageTable = process->getPageTable();
+        if (pageTable.empty()) continue;
+
+        uint32_t workingSet = 0;
+        pageTable.forEachAllocated([&](uint32_t, PageTableEntry& entry) {
+            entry.referenceHistory = static_cast<uint8_t>((entry.referenceHistory >> 1) | (entry.wsReferenced ? 0x80 : 0));
+            entry.wsReferenced = false;
+            if (entry.referenceHistory & WS_WINDOW_MASK) ++workingSet;
+        });
+
+        uint32_t pid = process->getPID();
+        workingSetSizes[pid] = workingSet;
+        if (residentCount(pid) > 0) total += workingSet;
+    }
+    totalWorkingSet = total;
+}
+
+// Pressure signal for the schedulers: true if dispatching the process would not push the
+// working sets past physical memory. Uses the same test as admitProcess but reserves nothing,
+// and processes that already have resident pages always fit
+bool MemoryManager::workingSetFits(Process& process) const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+
+    if (residentCount(process.getPID()) > 0 || totalWorkingSet == 0)
+        return true;
+
+    return totalWorkingSet + admissionEstimate(process) <= totalFrames;
+}
+
+uint32_t MemoryManager::getWorkingSetSize(uint32_t pid) const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    auto it = workingSetSizes.find(pid);
+    return it == workingSetSizes.end() ? 0 : it->second;
+}
+
+size_t MemoryManager::getTotalWorkingSet() const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    return totalWorkingSet;
+}
+
+// After a fault on vpn, loads the next pages of the process into free frames if the fault
+// continues a sequential run (previous fault was on vpn - 1). Never evicts to make room.
+// The window doubles when read-ahead pages get used and halves when they are evicted unused
+// (caller holds memoryMutex exclusively)
+void MemoryManager::readAheadAfterFault(Process& process, uint32_t vpn) {
+    ReadAheadState& state = readAheadStates[process.getPID()];
+    bool sequential = state.hasLastFault && vpn == state.lastFaultVpn + 1;
+    state.lastFaultVpn = vpn;
+    state.hasLastFault = true;
+    if (!sequential) return;
+
+    auto& pageTable = process.getPageTable();
+    size_t maxAllowedFrames = pageTable.size();     // Same cap as translateAddress
+
+    for (uint32_t next = vpn + 1; next <= vpn + state.window && next < pageTable.size(); ++next) {
+        if (pageTable[next].valid) continue;
+        if (residentCount(process.getPID()) >= maxAllowedFrames) break;
+
+        std::optional<uint32_t> frameNumber = allocateFrame();
+        if (!frameNumber) break;
+
+        loadPage(process, next, *frameNumber);
+
+        // Not accessed yet: leave the referenced bit clear so CLOCK can reclaim it first
+        pageTable[next].referenced = false;
+        pageTable[next].prefetched = true;
+        ++pagesPrefetched;
+
+        // The next sequential fault continues after the read-ahead pages
+        state.lastFaultVpn = next;
+    }
+}
+
+// Returns the TLB of the core the process is running on, or nullptr if it has none (caller holds memoryMutex)
+TLB* MemoryManager::tlbFor(const Process& process) const {
+    int coreId = process.getCoreID();
+    if (coreId < 0 || coreId >= static_cast<int>(tlbs.size())) return nullptr;
+    return tlbs[coreId];
+}
+
+// Drops a translation from every core's TLB after its page left memory (caller holds memoryMutex)
+void MemoryManager::shootDownTLBs(uint32_t pid, uint32_t vpn) {
+    for (TLB* tlb : tlbs) {
+        if (tlb) tlb->invalidate(pid, vpn);
+    }
+}
+
+// Called by a Core when it starts so its TLB is kept coherent with evictions
+void MemoryManager::registerTLB(int coreId, TLB* tlb) {
+    if (coreId < 0) return;
+
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+    if (coreId >= static_cast<int>(tlbs.size()))
+        tlbs.resize(coreId + 1, nullptr);
+    tlb->flush();
+    tlbs[coreId] = tlb;
+}
+
+// Called by a Core when it stops
+void MemoryManager::unregisterTLB(int coreId) {
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+    if (coreId >= 0 && coreId < static_cast<int>(tlbs.size()))
+        tlbs[coreId] = nullptr;
 }
 
 // Loads a page from backing store into a frame
-void MemoryManager::loadPage(std::shared_ptr<Process> process, uint32_t vpn, uint32_t frameNumber) {
-    // Load the page data from backing store (or initialize if not present)
-    loadPageFromBackingStore(process->getPID(), vpn, frameNumber);
+void MemoryManager::loadPage(Process& process, uint32_t vpn, uint32_t frameNumber) {
+    PageTableEntry& entry = process.getPageTable()[vpn];
+
+    // A page decompressed from the pool is no longer stored anywhere else, so it starts dirty
+    bool fromCompressedPool = false;
 
-    ++pagesPagedIn;
+    if (entry.zeroPage) {
+        // Demand-zero page: nothing is stored for it, so clear the frame without touching the backing store
+        const auto page = memory.begin() + frameNumber * frameSize;
+        std::fill(page, page + frameSize, 0);
+        ++zeroFillFaults;
+    } else if (compressedCache->load(process.getPID(), vpn, &memory[frameNumber * frameSize])) {
+        fromCompressedPool = true;
+    } else {
+        // Load the page data from the write-back queue or the backing store
+        loadPageFromBackingStore(process.getPID(), vpn, frameNumber);
+        ++pagesPagedIn;
+    }
 
     // Update the page table entry
-    PageTableEntry& entry = process->getPageTable()[vpn];
     entry.valid = true;
     entry.frameNumber = frameNumber;
-    entry.dirty = false;
+    entry.dirty = fromCompressedPool;
+    entry.referenced = true;
+    entry.checkpointDirty = true;
 
     // Update the frame table to reflect the new mapping
     frameTable[frameNumber].inUse = true;
-    frameTable[frameNumber].pfid = process->getPID();
+    frameTable[frameNumber].pfid = process.getPID();
     frameTable[frameNumber].virtualPageNumber = vpn;
+    residentFrames[process.getPID()].insert(frameNumber);
 
-    // Add this page to the FIFO queue for future eviction
-    fifoQueue.emplace_back(process->getPID(), vpn);
+    // Let the replacement policy track this frame for future eviction (mapHugeFrame
+    // registers a huge frame once, by its first frame)
+    if (!frameTable[frameNumber].huge)
+        replacementPolicy->onPageLoaded(frameNumber);
 }
 
+// Loads a page from the backing store into a frame. The read is queued until the fault that
+// needs it calls submitSwapReads
 void MemoryManager::loadPageFromBackingStore(uint32_t pid, uint32_t vpn, uint32_t frameNumber) {
-    const std::string filename = "csopesy-backing-store.txt";
-    const std::string header = "[PID " + std::to_string(pid) + " VPN " + std::to_string(vpn) + "]";
-    const std::string footer = "[/PID " + std::to_string(pid) + " VPN " + std::to_string(vpn) + "]";
     const uint32_t physicalAddress = frameNumber * frameSize;
 
-    std::ifstream inFile(filename);
-    bool found = false;
-
-    if (inFile) {
-        std::string line;
-        // Search for the header marking the start of the page data
-        while (std::getline(inFile, line)) {
-            if (line == header) {
-                found = true;
-                // Read each line as a byte of the page, until footer or frameSize is reached
-                for (size_t i = 0; i < frameSize && std::getline(inFile, line); ++i) {
-                    if (line == footer) break; // Stop if footer is reached early
-                    memory[physicalAddress + i] = static_cast<uint8_t>(std::stoi(line));
-                }
-                break;
-            }
+    // A page evicted before the daemon wrote it out is still in the write-back queue
+    if (readFromWriteBackQueue(pid, vpn, &memory[physicalAddress]))
+        return;
+
+    pendingSwapReads.push_back({ pid, vpn, &memory[physicalAddress], false });
+}
+
+// Reads every page queued by loadPageFromBackingStore as one batch, so pages in adjacent slots
+// come in with one I/O. The pages are already mapped; their frames are marked pagingIn, which
+// keeps eviction and compaction off them, and memoryMutex is released for the I/O so other
+// cores keep translating and faulting meanwhile. Only the faulting process's own thread uses
+// those pages, and it is waiting here (caller holds memoryMutex exclusively through lock)
+void MemoryManager::submitSwapReads(std::unique_lock<std::shared_mutex>& lock) {
+    if (pendingSwapReads.empty()) return;
+
+    // Other faults queue their own reads while this batch is in progress
+    std::vector<SwapIoRequest> reads;
+    reads.swap(pendingSwapReads);
+    for (const auto& read : reads)
+        frameTable[(read.data - memory.data()) / frameSize].pagingIn = true;
+
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+        swapIo->submit(reads);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    lock.lock();
+
+    for (const auto& read : reads) {
+        frameTable[(read.data - memory.data()) / frameSize].pagingIn = false;
+
+        // A page without a slot has never held data, so it reads as zeros
+        if (!read.found)
+            std::fill(read.data, read.data + frameSize, 0);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+// Checks if every byte of a frame is zero
+bool MemoryManager::isZeroFrame(uint32_t frameNumber) const {
+    const auto page = memory.begin() + frameNumber * frameSize;
+    return std::all_of(page, page + frameSize, [](uint8_t byte) { return byte == 0; });
+}
+
+// Before a dirty page is written out: if it is all zeros, mark it demand-zero, drop any copy
+// waiting in the write-back queue and release its slot instead of storing it.
+// Returns true if the page was dropped (caller holds memoryMutex exclusively)
+bool MemoryManager::dropIfZeroPage(uint32_t pid, uint32_t vpn, PageTableEntry& entry) {
+    if (!isZeroFrame(entry.frameNumber)) {
+        entry.checkpointDirty = entry.checkpointDirty || entry.zeroPage;
+        entry.zeroPage = false;
+        return false;
+    }
+
+    entry.checkpointDirty = entry.checkpointDirty || !entry.zeroPage;
+    entry.zeroPage = true;
+    {
+        std::unique_lock<std::mutex> lock(writeBackMutex);
+        eraseQueuedWriteBack(pid, vpn, lock);
+    }
+    backingStore->discardPage(pid, vpn);
+    ++zeroPagesDeduplicated;
+    return true;
+}
+
+// Background thread: periodically cleans dirty pages that are next in line for eviction
+// and writes queued pages to the backing store off the page-fault path
+void MemoryManager::writeBackLoop() {
+    while (writeBackRunning) {
+        {
+            std::unique_lock<std::mutex> lock(writeBackMutex);
+            writeBackCv.wait_for(lock, TICK_PERIOD, [this]() {
+                return !writeBackRunning || !writeBackQueue.empty();
+            });
         }
-        inFile.close();
+
+        if (!writeBackRunning) break;
+
+        queueDirtyPagesForWriteBack();
+
+        // Write everything queued as one slot-sorted batch. Pages stay readable until
+        // written, so a fault on one of them meanwhile still finds the latest copy.
+        std::unique_lock<std::mutex> lock(writeBackMutex);
+        drainWriteBackQueue(lock);
     }
+}
+
+// Writes the whole write-back queue to the backing store in one batch. The batch moves to
+// writeBackInFlight, where page-ins still find it, and writeBackMutex is released for the I/O
+// so faults can queue and read pages meanwhile. Only one batch is in flight at a time, so the
+// copies of a page reach the backing store in the order they were queued
+// (caller holds writeBackMutex through lock)
+void MemoryManager::drainWriteBackQueue(std::unique_lock<std::mutex>& lock) {
+    writeBackDone.wait(lock, [this]() { return writeBackInFlight.empty(); });
+    if (writeBackQueue.empty()) return;
+
+    writeBackInFlight.assign(std::make_move_iterator(writeBackQueue.begin()), std::make_move_iterator(writeBackQueue.end()));
+    writeBackQueue.clear();
+
+    std::vector<SwapIoRequest> batch;
+    batch.reserve(writeBackInFlight.size());
+    for (auto& request : writeBackInFlight)
+        batch.push_back({ request.pid, request.vpn, request.data.data(), true });
 
-    if (!found) {
-        // If the page was not found in the backing store, initialize with zeros
-        std::fill(memory.begin() + physicalAddress, memory.begin() + physicalAddress + frameSize, 0);
-        // Save the newly initialized page to the backing store for future use
-        savePageToBackingStore(pid, vpn, frameNumber);  
+    lock.unlock();
+    try {
+        swapIo->submit(batch);
+    } catch (...) {
+        // Put the pages back ahead of anything queued since, so no copy is lost or reordered
+        lock.lock();
+        writeBackQueue.insert(writeBackQueue.begin(), std::make_move_iterator(writeBackInFlight.begin()), std::make_move_iterator(writeBackInFlight.end()));
+        writeBackInFlight.clear();
+        writeBackDone.notify_all();
+        throw;
     }
+    lock.lock();
+
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& request : writeBackInFlight) {
+        totalWriteBackLatencyUs += std::chrono::duration_cast<std::chrono::microseconds>(now - request.enqueuedAt).count();
+        ++pagesWrittenBack;
+        ++pagesPagedOut;
+    }
+    writeBackInFlight.clear();
+    writeBackDone.notify_all();
 }
 
-void MemoryManager::savePageToBackingStore(uint32_t pid, uint32_t vpn, uint32_t frameNumber) {
-    const std::string filename = "csopesy-backing-store.txt";
-    const std::string header = "[PID " + std::to_string(pid) + " VPN " + std::to_string(vpn) + "]";
-    const std::string footer = "[/PID " + std::to_string(pid) + " VPN " + std::to_string(vpn) + "]";
-    const uint32_t physicalAddress = frameNumber * frameSize;
+// Removes queued copies of a page that a newer copy supersedes. A copy already being written
+// is waited for first, so it cannot land on top of whatever replaces it
+// (caller holds writeBackMutex through lock)
+void MemoryManager::eraseQueuedWriteBack(uint32_t pid, uint32_t vpn, std::unique_lock<std::mutex>& lock) {
+    writeBackDone.wait(lock, [this, pid, vpn]() {
+        return std::none_of(writeBackInFlight.begin(), writeBackInFlight.end(),
+                            [pid, vpn](const WriteBackRequest& request) {
+                                return request.pid == pid && request.vpn == vpn;
+                            });
+    });
 
-    std::ifstream inFile(filename);
-    std::stringstream buffer;
-    bool replaced = false;
-    bool skip = false;
-
-    if (inFile) {
-        std::string line;
-        // Read the file line by line
-        while (std::getline(inFile, line)) {
-            if (line == header) {
-                // Found the header for this page, so we will replace this section
-                skip = true;
-                replaced = true;
-                buffer << header << "\n";
-                // Write the current page data from memory to the buffer
-                for (size_t i = 0; i < frameSize; ++i)
-                    buffer << std::to_string(memory[physicalAddress + i]) << "\n";
-                buffer << footer << "\n";
-
-                // Skip lines until the footer is found
-                while (std::getline(inFile, line)) {
-                    if (line == footer) {
-                        skip = false;
-                        break;
-                    }
-                }
-                continue;
-            }
-            if (!skip) {
-                // Copy lines not being replaced
-                buffer << line << "\n";
+    writeBackQueue.erase(
+        std::remove_if(writeBackQueue.begin(), writeBackQueue.end(),
+                       [pid, vpn](const WriteBackRequest& request) {
+                           return request.pid == pid && request.vpn == vpn;
+                       }),
+        writeBackQueue.end()
+    );
+}
+
+// Tries to keep an evicted dirty page in the compressed pool instead of writing it out.
+// Pages the pool pushes out to make room are written to the backing store as one batch
+// (caller holds memoryMutex exclusively)
+bool MemoryManager::compressToPool(uint32_t pid, uint32_t vpn, uint32_t frameNumber) {
+    std::vector<EvictedPage> evicted;
+    if (!compressedCache->store(pid, vpn, &memory[frameNumber * frameSize], evicted))
+        return false;
+
+    // The pool now holds the newest copy
+    {
+        std::unique_lock<std::mutex> lock(writeBackMutex);
+        eraseQueuedWriteBack(pid, vpn, lock);
+    }
+
+    if (!evicted.empty()) {
+        std::vector<SwapIoRequest> batch;
+        batch.reserve(evicted.size());
+        for (auto& page : evicted)
+            batch.push_back({ page.pid, page.vpn, page.data.data(), true });
+        swapIo->submit(batch);
+        pagesPagedOut += static_cast<uint32_t>(evicted.size());
+    }
+    return true;
+}
+
+// Eviction burst: the write-back queue is full, so write the victim page together with
+// everything queued in one batch instead of a synchronous write per page
+void MemoryManager::writeBackWithQueue(uint32_t pid, uint32_t vpn, uint32_t frameNumber) {
+    std::unique_lock<std::mutex> lock(writeBackMutex);
+
+    // Drop a stale queued copy of the victim; the frame holds the newer one
+    eraseQueuedWriteBack(pid, vpn, lock);
+
+    const auto page = memory.begin() + frameNumber * frameSize;
+    writeBackQueue.push_back({ pid, vpn, std::vector<uint8_t>(page, page + frameSize), std::chrono::steady_clock::now() });
+    drainWriteBackQueue(lock);
+}
+
+// Snapshots dirty pages the replacement policy will evict next into the
+// write-back queue and marks them clean, so their eviction needs no I/O
+void MemoryManager::queueDirtyPagesForWriteBack() {
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+
+    // Returns false once the queue is full
+    auto cleanFrame = [this](uint32_t frameNumber) {
+        uint32_t pid = frameTable[frameNumber].pfid;
+        uint32_t vpn = frameTable[frameNumber].virtualPageNumber;
+
+        std::shared_ptr<Process> process = Process::getProcessByPID(pid);
+        if (!process) return true;
+
+        auto& pageTable = process->getPageTable();
+        if (vpn >= pageTable.size()) return true;
+
+        PageTableEntry& entry = pageTable[vpn];
+        if (!entry.valid || !entry.dirty) return true;
+
+        if (dropIfZeroPage(pid, vpn, entry)) {
+            entry.dirty = false;
+            return true;
+        }
+        if (!enqueueWriteBack(pid, vpn, entry.frameNumber)) return false;
+        entry.dirty = false;
+        return true;
+    };
+
+    // Every page of a huge frame victim leaves with it
+    for (uint32_t frameNumber : replacementPolicy->peekVictims(WRITEBACK_QUEUE_CAPACITY)) {
+        for (uint32_t i = 0; i < mappedFrameCount(frameNumber); ++i) {
+            if (!cleanFrame(frameNumber + i)) return;
+        }
+    }
+}
+
+// Copies a frame into the write-back queue, returns false if the queue is full
+bool MemoryManager::enqueueWriteBack(uint32_t pid, uint32_t vpn, uint32_t frameNumber) {
+    const auto page = memory.begin() + frameNumber * frameSize;
+    {
+        std::lock_guard<std::mutex> lock(writeBackMutex);
+
+        // Refresh the queued copy if this page is already waiting
+        for (auto& request : writeBackQueue) {
+            if (request.pid == pid && request.vpn == vpn) {
+                request.data.assign(page, page + frameSize);
+                return true;
             }
         }
-        inFile.close();
+
+        if (writeBackQueue.size() >= WRITEBACK_QUEUE_CAPACITY)
+            return false;
+
+        writeBackQueue.push_back({ pid, vpn, std::vector<uint8_t>(page, page + frameSize), std::chrono::steady_clock::now() });
     }
+    writeBackCv.notify_one();
+    return true;
+}
 
-    if (!replaced) {
-        // If the page was not found, append it at the end
-        buffer << header << "\n";
-        for (size_t i = 0; i < frameSize; ++i)
-            buffer << std::to_string(memory[physicalAddress + i]) << "\n";
-        buffer << footer << "\n";
+// Serves a page-in from the write-back queue, or from the batch being written, if the page has
+// not reached the backing store yet. A queued copy is newer than one in the batch
+bool MemoryManager::readFromWriteBackQueue(uint32_t pid, uint32_t vpn, uint8_t* dest) {
+    std::lock_guard<std::mutex> lock(writeBackMutex);
+    auto matches = [pid, vpn](const WriteBackRequest& request) {
+        return request.pid == pid && request.vpn == vpn;
+    };
+
+    auto queued = std::find_if(writeBackQueue.begin(), writeBackQueue.end(), matches);
+    if (queued != writeBackQueue.end()) {
+        std::copy(queued->data.begin(), queued->data.end(), dest);
+        return true;
+    }
+    auto inFlight = std::find_if(writeBackInFlight.begin(), writeBackInFlight.end(), matches);
+    if (inFlight != writeBackInFlight.end()) {
+        std::copy(inFlight->data.begin(), inFlight->data.end(), dest);
+        return true;
     }
+    return false;
+}
+
+// Copies the saved contents of a non-resident page from wherever they are kept (compressed
+// pool, write-back queue or backing store) without taking them out. Returns false if the
+// page has never been saved
+bool MemoryManager::readStoredPage(uint32_t pid, uint32_t vpn, uint8_t* dest) {
+    if (compressedCache->peek(pid, vpn, dest) || readFromWriteBackQueue(pid, vpn, dest))
+        return true;
+
+    std::vector<SwapIoRequest> read{ { pid, vpn, dest, false } };
+    swapIo->submit(read);
+    return read.front().found;
+}
+
+size_t MemoryManager::getWriteBackQueueDepth() const {
+    std::lock_guard<std::mutex> lock(writeBackMutex);
+    return writeBackQueue.size();
+}
 
-    // Write the updated buffer back to the file
-    std::ofstream outFile(filename);
-    outFile << buffer.str();
-    outFile.close();
+double MemoryManager::getAverageWriteBackLatencyMs() const {
+    uint64_t written = pagesWrittenBack;
+    return written == 0 ? 0.0 : static_cast<double>(totalWriteBackLatencyUs) / written / 1000.0;
+}
+
+// Stops the write-back daemon and writes out any pages still queued
+void MemoryManager::shutdown() {
+    if (!writeBackRunning.exchange(false)) return;
+
+    writeBackCv.notify_all();
+    if (writeBackThread.joinable())
+        writeBackThread.join();
+
+    std::unique_lock<std::mutex> lock(writeBackMutex);
+    drainWriteBackQueue(lock);
+    backingStore->flush();
 }
 
 // Reads a 16-bit unsigned integer from the given physical address in memory
@@ -286,68 +1456,495 @@ void MemoryManager::writeUint16At(uint32_t physicalAddress, uint16_t value) {
     // Store the lower and upper bytes (little-endian)
     memory[physicalAddress]     = static_cast<uint8_t>(value & 0xFF);
     memory[physicalAddress + 1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    changedFrames[physicalAddress / frameSize].store(true, std::memory_order_relaxed);
+    changedFrames[(physicalAddress + 1) / frameSize].store(true, std::memory_order_relaxed);
 }
 
 // Frees all pages/frames owned by the process with the given PID
 void MemoryManager::freeProcessPages(uint32_t pid) {
-    // Mark all frames owned by this process as free
-    for (auto& frame : frameTable) {
-        if (frame.inUse && frame.pfid == pid) {
-            frame.inUse = false;
-            frame.pfid = -1;
-            frame.virtualPageNumber = -1;
+    std::vector<std::shared_ptr<Process>> woken;
+    {
+        std::unique_lock<std::shared_mutex> lock(memoryMutex);
+
+        // Free only the frames in this process's resident set
+        auto resident = residentFrames.find(pid);
+        if (resident != residentFrames.end()) {
+            for (uint32_t frameNumber : resident->second) {
+                // A frame shared copy-on-write stays resident for its other mappings
+                if (!frameTable[frameNumber].sharers.empty()) {
+                    detachSharer(frameNumber, pid);
+                    continue;
+                }
+
+                replacementPolicy->onFrameFreed(frameNumber);
+                releaseFrame(frameNumber);
+                frameTable[frameNumber].pfid = -1;
+                frameTable[frameNumber].virtualPageNumber = -1;
+            }
+            residentFrames.erase(resident);
+        }
+        readAheadStates.erase(pid);
+
+        // Drop the process's segment mappings and open handles, then free segments nobody uses
+        auto mappings = sharedMappings.find(pid);
+        if (mappings != sharedMappings.end()) {
+            for (uint32_t frameNumber : mappings->second)
+                --frameTable[frameNumber].refCount;
+            sharedMappings.erase(mappings);
         }
+        for (auto& [name, segment] : sharedSegments)
+            segment.openers.erase(pid);
+        releaseUnusedSharedSegments();
+
+        // The process's working set no longer competes for frames
+        auto workingSet = workingSetSizes.find(pid);
+        if (workingSet != workingSetSizes.end()) {
+            totalWorkingSet -= std::min<size_t>(totalWorkingSet, workingSet->second);
+            workingSetSizes.erase(workingSet);
+        }
+
+        // Drop the process's cached translations from every core
+        for (TLB* tlb : tlbs) {
+            if (tlb) tlb->invalidateProcess(pid);
+        }
+
+        // Invalidate all page table entries for this process
+        if (auto process = Process::getProcessByPID(pid)) {
+            process->getPageTable().forEachAllocated([](uint32_t, PageTableEntry& entry) {
+                entry.valid = false;
+                entry.frameNumber = -1;
+                entry.dirty = false;
+                entry.copyOnWrite = false;
+                entry.sharedMemory = false;
+                entry.checkpointDirty = true;
+            });
+        }
+
+        // Drop pages still waiting for write-back, then release the process's swap slots for reuse.
+        // Pages already being written are waited for, or they would recreate the swap file
+        {
+            std::unique_lock<std::mutex> writeBackLock(writeBackMutex);
+            writeBackDone.wait(writeBackLock, [this, pid]() {
+                return std::none_of(writeBackInFlight.begin(), writeBackInFlight.end(),
+                                    [pid](const WriteBackRequest& request) {
+                                        return request.pid == pid;
+                                    });
+            });
+            writeBackQueue.erase(
+                std::remove_if(writeBackQueue.begin(), writeBackQueue.end(),
+                               [pid](const WriteBackRequest& request) {
+                                   return request.pid == pid;
+                               }),
+                writeBackQueue.end()
+            );
+        }
+        backingStore->releaseProcess(pid);
+        compressedCache->releaseProcess(pid);
+
+        // A process freed while still waiting for memory no longer needs waking
+        memoryWaitQueue.erase(
+            std::remove_if(memoryWaitQueue.begin(), memoryWaitQueue.end(),
+                           [pid](const std::shared_ptr<Process>& process) {
+                               return process->getPID() == static_cast<int>(pid);
+                           }),
+            memoryWaitQueue.end()
+        );
+
+        // Wake as many waiting processes as there are frames now free
+        woken = wakeMemoryWaiters();
     }
 
-    // Invalidate all page table entries for this process
-    auto it = Process::pidToProcess.find(pid);
-    if (it != Process::pidToProcess.end()) {
-        auto process = it->second;
-        for (auto& entry : process->getPageTable()) {
-            entry.valid = false;
-            entry.frameNumber = -1;
-            entry.dirty = false;
+    // Hand woken processes back to the scheduler outside memoryMutex, so a core holding
+    // memoryMutex never waits on the scheduler's ready-queue lock
+    if (auto scheduler = GlobalScheduler::getInstance()) {
+        for (auto& process : woken)
+            scheduler->requeueProcess(process);
+    }
+}
+
+// Blocks a process that cannot get a frame and parks it at the back of the memory wait queue
+// (caller holds memoryMutex exclusively)
+void MemoryManager::blockOnMemory(Process& process) {
+    process.setState(ProcessState::Blocked);
+    if (process.isWaitingOnPageFault()) return;
+
+    process.setWaitingOnPageFault(true);
+    memoryWaitQueue.push_back(process.shared_from_this());
+}
+
+// Terminates a process whose access falls outside its address space, the same way READ and
+// WRITE do when they catch the violation first. The scheduler then frees its memory and
+// unregisters it (caller holds memoryMutex exclusively)
+void MemoryManager::terminateOnViolation(Process& process, uint32_t virtualAddress) {
+    process.markTerminatedByMemoryViolation(virtualAddress);
+    process.setState(ProcessState::Terminated);
+}
+
+// Pops waiting processes in FIFO order and marks them Ready: one per free frame, then any
+// whose admission estimate still fits in the working-set headroom (frames not claimed by the
+// working sets of resident processes), so a process admission control turned away is not
+// left waiting for a frame to be freed. Entries whose process already left the Blocked state
+// are dropped without using up either budget.
+// Returns the processes the caller must hand back to the scheduler (caller holds memoryMutex exclusively)
+std::vector<std::shared_ptr<Process>> MemoryManager::wakeMemoryWaiters() {
+    std::vector<std::shared_ptr<Process>> woken;
+    size_t wakeBudget = frameAllocator.getFreeCount();
+    size_t headroom = totalFrames > totalWorkingSet ? totalFrames - totalWorkingSet : 0;
+
+    while (!memoryWaitQueue.empty()) {
+        std::shared_ptr<Process> process = memoryWaitQueue.front();
+        if (process->getState() == ProcessState::Blocked && woken.size() >= wakeBudget) {
+            size_t estimate = std::max<size_t>(admissionEstimate(*process), 1);
+            if (estimate > headroom) break;
+            headroom -= estimate;
         }
+
+        memoryWaitQueue.pop_front();
+        process->setWaitingOnPageFault(false);
+
+        if (process->getState() != ProcessState::Blocked) continue;
+        process->setState(ProcessState::Ready);
+        woken.push_back(process);
     }
+    return woken;
+}
 
-    // Remove all entries for this process from the FIFO queue
-    fifoQueue.erase(
-        std::remove_if(fifoQueue.begin(), fifoQueue.end(),
-                       [pid](const std::pair<uint32_t, uint32_t>& p) {
-                           return p.first == pid;
-                       }),
-        fifoQueue.end()
-    );
+size_t MemoryManager::getMemoryWaitQueueDepth() const {
+    std::shared_lock<std::shared_mutex> lock(memoryMutex);
+    return memoryWaitQueue.size();
+}
 
-    // Try to unblock any processes that may now have enough memory
-    tryUnblockingBlockedProcesses();
+// Page table entry flags as stored in a checkpoint, one bit each
+static uint8_t packEntryFlags(const PageTableEntry& entry) {
+    return static_cast<uint8_t>(entry.valid | entry.dirty << 1 | entry.referenced << 2 | entry.zeroPage << 3 |
+                                entry.prefetched << 4 | entry.wsReferenced << 5 | entry.copyOnWrite << 6 |
+                                entry.sharedMemory << 7);
 }
 
-// Checks if a blocked process can be unblocked (has room for more frames and a free frame exists)
-bool MemoryManager::canUnblock(std::shared_ptr<Process> process) {
-    size_t framesOwned = 0;
-    // Count frames currently owned by the process
-    for (const auto& frame : frameTable) {
-        if (frame.inUse && frame.pfid == process->getPID())
-            ++framesOwned;
+static void unpackEntryFlags(uint8_t flags, PageTableEntry& entry) {
+    entry.valid = flags & 1;
+    entry.dirty = flags & 2;
+    entry.referenced = flags & 4;
+    entry.zeroPage = flags & 8;
+    entry.prefetched = flags & 16;
+    entry.wsReferenced = flags & 32;
+    entry.copyOnWrite = flags & 64;
+    entry.sharedMemory = flags & 128;
+}
+
+static std::runtime_error corruptCheckpoint() {
+    return std::runtime_error("Checkpoint file is truncated or corrupt.");
+}
+
+// Writes physical memory state for a checkpoint: the frame table, the shared-memory segments,
+// the page tables of the given processes, the contents of their pages saved outside memory
+// (pool, write-back queue or backing store) and the memory wait queue.
+// A full checkpoint writes every allocated frame's contents and every page table. An incremental
+// one writes only the contents of changedFrames and the page table entries marked checkpointDirty,
+// except for processes missing from checkpointedPids (the processes of the checkpoint it builds
+// on), whose tables are written whole. Both clear the change marks, so the next incremental
+// checkpoint builds on this one. Holds memoryMutex exclusively, so nothing is paged while the
+// copy is taken. Returns the number of frames whose contents were written
+uint32_t MemoryManager::writeCheckpoint(CheckpointWriter& out, const std::vector<std::shared_ptr<Process>>& processes,
+                                        bool incremental, const std::unordered_set<int>& checkpointedPids) {
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+
+    out.write(memorySize);
+    out.write(frameSize);
+
+    uint32_t framesWritten = 0;
+    out.write(totalFrames - frameAllocator.getFreeCount());
+    for (uint32_t frameNumber = 0; frameNumber < totalFrames; ++frameNumber) {
+        bool changed = changedFrames[frameNumber].exchange(false);
+        if (frameAllocator.isFree(frameNumber)) continue;
+
+        const PageFrame& frame = frameTable[frameNumber];
+        out.write(frameNumber);
+        out.write(static_cast<int32_t>(frame.pfid));
+        out.write(frame.virtualPageNumber);
+        out.write(frame.inUse);
+        out.write(frame.huge);
+        out.write(frame.refCount);
+        out.write(static_cast<uint32_t>(frame.sharers.size()));
+        for (uint32_t pid : frame.sharers)
+            out.write(pid);
+
+        bool withContents = !incremental || changed;
+        out.write(withContents);
+        if (withContents) {
+            out.writeBytes(&memory[frameNumber * frameSize], frameSize);
+            ++framesWritten;
+        }
+    }
+
+    out.write(static_cast<uint32_t>(sharedSegments.size()));
+    for (const auto& [name, segment] : sharedSegments) {
+        out.writeString(name);
+        out.write(static_cast<uint32_t>(segment.frames.size()));
+        for (uint32_t frameNumber : segment.frames)
+            out.write(frameNumber);
+        out.write(static_cast<uint32_t>(segment.openers.size()));
+        for (uint32_t pid : segment.openers)
+            out.write(pid);
+    }
+
+    out.write(static_cast<uint32_t>(sharedMappings.size()));
+    for (const auto& [pid, frames] : sharedMappings) {
+        out.write(pid);
+        out.write(static_cast<uint32_t>(frames.size()));
+        for (uint32_t frameNumber : frames)
+            out.write(frameNumber);
+    }
+
+    // A whole table skips entries still in their initial state (never touched, or demand-zero
+    // with no history); a partial one holds exactly the entries whose mapping changed
+    auto shouldSave = [](const PageTableEntry& entry, bool whole) {
+        return whole ? entry.valid || !entry.zeroPage || entry.referenceHistory != 0 : entry.checkpointDirty;
+    };
+
+    struct TableToSave {
+        Process* process;
+        bool whole;
+        uint32_t entries;
+    };
+    std::vector<TableToSave> tables;
+    for (const auto& process : processes) {
+        bool whole = !incremental || !checkpointedPids.count(process->getPID());
+        uint32_t entries = 0;
+        process->getPageTable().forEachAllocated([&](uint32_t, PageTableEntry& entry) {
+            if (shouldSave(entry, whole)) ++entries;
+        });
+        if (whole || entries > 0)
+            tables.push_back({ process.get(), whole, entries });
     }
 
-    // Calculate the maximum frames allowed for this process
-    size_t maxAllowedFrames = process->getMemoryRequired() / frameSize;
-    bool hasRoomForMoreFrames = framesOwned < maxAllowedFrames;
-    bool hasFreeFrame = findFreeFrame() != -1;
+    std::vector<uint8_t> page(frameSize);
+    out.write(static_cast<uint32_t>(tables.size()));
+    for (const TableToSave& table : tables) {
+        auto& pageTable = table.process->getPageTable();
+        uint32_t pid = table.process->getPID();
 
-    // Can unblock if process can own more frames and a free frame exists
-    return hasRoomForMoreFrames && hasFreeFrame;
+        out.write(pid);
+        out.write(pageTable.size());
+        out.write(table.whole);
+        out.write(table.entries);
+        pageTable.forEachAllocated([&](uint32_t vpn, PageTableEntry& entry) {
+            bool save = shouldSave(entry, table.whole);
+            entry.checkpointDirty = false;
+            if (!save) return;
+
+            out.write(vpn);
+            out.write(packEntryFlags(entry));
+            out.write(entry.referenceHistory);
+            out.write(entry.frameNumber);
+
+            // A page out of memory carries its saved contents, or zeros if it was never saved
+            if (!entry.valid && !entry.zeroPage) {
+                if (!readStoredPage(pid, vpn, page.data()))
+                    std::fill(page.begin(), page.end(), 0);
+                out.writeBytes(page.data(), frameSize);
+            }
+        });
+    }
+
+    out.write(static_cast<uint32_t>(memoryWaitQueue.size()));
+    for (const auto& process : memoryWaitQueue)
+        out.write(static_cast<uint32_t>(process->getPID()));
+
+    return framesWritten;
 }
 
-// Attempts to unblock all blocked processes that can now proceed
-void MemoryManager::tryUnblockingBlockedProcesses() {
-    for (auto& [pid, process] : Process::pidToProcess) {
-        if (process->getState() == ProcessState::Blocked &&
-            canUnblock(process)) {
-            process->setState(ProcessState::Ready);
-            GlobalScheduler::getInstance()->addProcess(process);
+// Reads what writeCheckpoint wrote into image, on top of what earlier files of the chain left
+// there: frame contents and page table entries the file does not hold keep their earlier values,
+// while the frame table, segments and wait queue are replaced. Page tables go into the given
+// (not yet running) processes. Nothing of the running system is touched
+void MemoryManager::readCheckpoint(CheckpointReader& in, MemoryImage& image,
+                                   const std::unordered_map<uint32_t, std::shared_ptr<Process>>& processByPid) {
+    uint32_t savedMemorySize = in.read<uint32_t>();
+    uint32_t savedFrameSize = in.read<uint32_t>();
+    if (savedMemorySize != memorySize || savedFrameSize != frameSize) {
+        throw std::runtime_error("Checkpoint was taken with " + std::to_string(savedMemorySize) + " bytes of memory in " +
+                                 std::to_string(savedFrameSize) + "-byte frames, but this system has " +
+                                 std::to_string(memorySize) + " bytes in " + std::to_string(frameSize) + "-byte frames.");
+    }
+
+    auto readFrameNumber = [&]() {
+        uint32_t frameNumber = in.read<uint32_t>();
+        if (frameNumber >= totalFrames) throw corruptCheckpoint();
+        return frameNumber;
+    };
+
+    if (image.memory.empty())
+        image.memory.assign(memorySize, 0);
+    image.frames.assign(totalFrames, PageFrame{});
+    image.allocator = FrameAllocator(totalFrames);
+
+    uint32_t allocatedFrames = in.readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < allocatedFrames; ++i) {
+        uint32_t frameNumber = readFrameNumber();
+        if (!image.allocator.take(frameNumber)) throw corruptCheckpoint();
+
+        PageFrame& frame = image.frames[frameNumber];
+        frame.pfid = in.read<int32_t>();
+        frame.virtualPageNumber = in.read<uint32_t>();
+        frame.inUse = in.read<bool>();
+        frame.huge = in.read<bool>();
+        frame.refCount = in.read<uint32_t>();
+        uint32_t sharerCount = in.readCount(sizeof(uint32_t));
+        for (uint32_t s = 0; s < sharerCount; ++s)
+            frame.sharers.push_back(in.read<uint32_t>());
+        if (in.read<bool>())
+            in.readBytes(&image.memory[frameNumber * frameSize], frameSize);
+    }
+
+    image.segments.clear();
+    uint32_t segmentCount = in.readCount();
+    for (uint32_t i = 0; i < segmentCount; ++i) {
+        SharedSegment& segment = image.segments[in.readString()];
+        uint32_t frameCount = in.readCount(sizeof(uint32_t));
+        for (uint32_t f = 0; f < frameCount; ++f)
+            segment.frames.push_back(readFrameNumber());
+        uint32_t openerCount = in.readCount(sizeof(uint32_t));
+        for (uint32_t o = 0; o < openerCount; ++o)
+            segment.openers.insert(in.read<uint32_t>());
+    }
+
+    image.mappings.clear();
+    uint32_t mappingCount = in.readCount();
+    for (uint32_t i = 0; i < mappingCount; ++i) {
+        std::vector<uint32_t>& frames = image.mappings[in.read<uint32_t>()];
+        uint32_t frameCount = in.readCount(sizeof(uint32_t));
+        for (uint32_t f = 0; f < frameCount; ++f)
+            frames.push_back(readFrameNumber());
+    }
+
+    uint32_t tableCount = in.readCount();
+    for (uint32_t i = 0; i < tableCount; ++i) {
+        uint32_t pid = in.read<uint32_t>();
+        auto owner = processByPid.find(pid);
+        if (owner == processByPid.end()) throw corruptCheckpoint();
+
+        Process& process = *owner->second;
+        uint32_t tableSize = in.read<uint32_t>();
+        if (in.read<bool>()) {
+            process.initPageTable(tableSize);
+            image.storedPages.erase(image.storedPages.lower_bound({ pid, 0 }),
+                                    image.storedPages.upper_bound({ pid, UINT32_MAX }));
+        } else if (process.getPageTable().size() != tableSize) {
+            throw corruptCheckpoint();
         }
+        auto& pageTable = process.getPageTable();
+
+        uint32_t entryCount = in.readCount();
+        for (uint32_t e = 0; e < entryCount; ++e) {
+            uint32_t vpn = in.read<uint32_t>();
+            if (vpn >= pageTable.size()) throw corruptCheckpoint();
+
+            PageTableEntry& entry = pageTable[vpn];
+            entry = PageTableEntry{};
+            unpackEntryFlags(in.read<uint8_t>(), entry);
+            entry.referenceHistory = in.read<uint8_t>();
+            entry.frameNumber = in.read<uint32_t>();
+            if (entry.valid && entry.frameNumber >= totalFrames) throw corruptCheckpoint();
+
+            if (!entry.valid && !entry.zeroPage) {
+                std::vector<uint8_t>& page = image.storedPages[{ pid, vpn }];
+                page.resize(frameSize);
+                in.readBytes(page.data(), frameSize);
+            } else {
+                image.storedPages.erase({ pid, vpn });
+            }
+        }
+    }
+
+    image.waitQueue.clear();
+    uint32_t waitingCount = in.readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < waitingCount; ++i) {
+        uint32_t pid = in.read<uint32_t>();
+        if (!processByPid.count(pid)) throw corruptCheckpoint();
+        image.waitQueue.push_back(pid);
+    }
+}
+
+// Makes a checkpoint read by readCheckpoint the running state. The restored processes' saved
+// pages go back to a cleared backing store, and the process registry is swapped while
+// memoryMutex is still held so no pager or write-back scan ever sees old processes against the
+// new frames. Policy order, working sets and read-ahead windows start over, and nothing counts
+// as changed for the next incremental checkpoint
+void MemoryManager::restoreCheckpoint(MemoryImage& image, const std::vector<std::shared_ptr<Process>>& processes,
+                                      const std::vector<std::shared_ptr<Process>>& registered) {
+    std::unordered_map<uint32_t, std::shared_ptr<Process>> processByPid;
+    for (const auto& process : processes) {
+        processByPid[process->getPID()] = process;
+
+        // The backing store starts out empty, so a resident page with contents must be
+        // written out if it is evicted, like a freshly cloned one
+        process->getPageTable().forEachAllocated([](uint32_t, PageTableEntry& entry) {
+            if (entry.valid && !entry.sharedMemory)
+                entry.dirty = entry.dirty || !entry.zeroPage;
+        });
+    }
+
+    std::vector<SwapIoRequest> savedPages;
+    for (auto& [key, page] : image.storedPages) {
+        if (processByPid.count(key.first))
+            savedPages.push_back({ key.first, key.second, page.data(), true });
+    }
+
+    std::deque<std::shared_ptr<Process>> restoredWaitQueue;
+    for (uint32_t pid : image.waitQueue) {
+        auto waiting = processByPid.find(pid);
+        if (waiting != processByPid.end())
+            restoredWaitQueue.push_back(waiting->second);
     }
-}
\ No newline at end of file
+
+    std::unique_lock<std::shared_mutex> lock(memoryMutex);
+
+    memory.swap(image.memory);
+    frameTable.swap(image.frames);
+    frameAllocator = std::move(image.allocator);
+    sharedSegments.swap(image.segments);
+    sharedMappings.swap(image.mappings);
+    for (auto& changed : changedFrames)
+        changed = false;
+
+    pinnedFrames = 0;
+    for (const auto& [name, segment] : sharedSegments)
+        pinnedFrames += static_cast<uint32_t>(segment.frames.size());
+
+    // Resident sets and the policy follow the frame table; segment frames are owned by no process
+    residentFrames.clear();
+    replacementPolicy = PageReplacementPolicy::create(replacementPolicy->getName(), totalFrames);
+    for (uint32_t frameNumber = 0; frameNumber < totalFrames; ++frameNumber) {
+        const PageFrame& frame = frameTable[frameNumber];
+        if (frameAllocator.isFree(frameNumber) || !frame.inUse || frame.pfid < 0) continue;
+
+        residentFrames[frame.pfid].insert(frameNumber);
+        for (uint32_t pid : frame.sharers)
+            residentFrames[pid].insert(frameNumber);
+        if (trackedFrame(frameNumber) == frameNumber)
+            replacementPolicy->onPageLoaded(frameNumber);
+    }
+
+    readAheadStates.clear();
+    workingSetSizes.clear();
+    totalWorkingSet = 0;
+    for (TLB* tlb : tlbs) {
+        if (tlb) tlb->flush();
+    }
+
+    memoryWaitQueue = std::move(restoredWaitQueue);
+    for (auto& process : memoryWaitQueue)
+        process->setWaitingOnPageFault(true);
+
+    {
+        std::unique_lock<std::mutex> writeBackLock(writeBackMutex);
+        writeBackDone.wait(writeBackLock, [this]() { return writeBackInFlight.empty(); });
+        writeBackQueue.clear();
+    }
+    compressedCache->clear();
+    backingStore->releaseAll();
+    swapIo->submit(savedPages);
+
+    Process::replaceRegistry(registered);
+}
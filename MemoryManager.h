@@ -1,38 +1,119 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <deque>
 #include <fstream>
+#include <map>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <cstdint>
 #include <optional>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
 
 #include "SystemConfig.h"
-
-struct PageTableEntry {
-    bool valid;
-    bool dirty;
-    uint32_t frameNumber;
-};
+#include "SwapDirectory.h"
+#include "SwapIoQueue.h"
+#include "CompressedPageCache.h"
+#include "FrameAllocator.h"
+#include "PageTable.h"
+#include "PageReplacementPolicy.h"
+#include "TLB.h"
 
 struct PageFrame {
     int pfid;
     uint32_t virtualPageNumber;
     bool inUse = false;
+    std::vector<uint32_t> sharers;  // Clones mapping the same vpn copy-on-write, besides pfid
+    uint32_t refCount = 0;          // Page tables mapping this frame through a shared-memory segment
+    bool huge = false;              // Part of a huge frame mapping; the policy only tracks its first frame
+    bool pagingIn = false;          // Being filled from swap with memoryMutex released: never evicted or moved
+};
+
+/**
+ * @struct SharedSegment
+ * @brief Named set of pinned frames that SHM_ATTACH maps into several processes' page tables.
+ */
+struct SharedSegment {
+    std::vector<uint32_t> frames;
+    std::unordered_set<uint32_t> openers;   // Processes that opened it with SHM_OPEN
+};
+
+/**
+ * @enum SharedMemoryStatus
+ * @brief Outcome of opening or attaching a shared-memory segment.
+ */
+enum class SharedMemoryStatus {
+    Ok,
+    NoMemory,   // Not enough frames yet; the process was blocked and retries when woken
+    NoSegment,  // No segment with that name is open
+    Invalid     // Bad size, or the segment does not fit at that address
+};
+
+/**
+ * @struct WriteBackRequest
+ * @brief Snapshot of a dirty page waiting to be written to the backing store by the write-back daemon.
+ */
+struct WriteBackRequest {
+    uint32_t pid;
+    uint32_t vpn;
+    std::vector<uint8_t> data;
+    std::chrono::steady_clock::time_point enqueuedAt;
+};
+
+/**
+ * @struct ReadAheadState
+ * @brief Per-process sequential fault detection and adaptive read-ahead window.
+ */
+struct ReadAheadState {
+    bool hasLastFault = false;
+    uint32_t lastFaultVpn = 0;
+    uint32_t window = 2;        // Pages read ahead on the next sequential fault
+};
+
+/**
+ * @struct MemoryImage
+ * @brief Memory state read from a checkpoint and the incremental checkpoints on top of it,
+ *        held aside until MemoryManager::restoreCheckpoint makes it the running state.
+ *        Page tables are read into the restored Process objects.
+ */
+struct MemoryImage {
+    std::vector<uint8_t> memory;
+    std::vector<PageFrame> frames;
+    FrameAllocator allocator;
+    std::unordered_map<std::string, SharedSegment> segments;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> mappings;
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<uint8_t>> storedPages;  // (pid, vpn) -> contents of a page out of memory
+    std::vector<uint32_t> waitQueue;    // pids, oldest first
 };
 
 class Process;
+class CheckpointReader;
+class CheckpointWriter;
 
 class MemoryManager {
 public:
     static void initialize(const SystemConfig& config);
     static std::shared_ptr<MemoryManager> getInstance();
+    static void destroy();
+    ~MemoryManager();
 
     void allocatePageTable(std::shared_ptr<Process> process);
-    std::optional<uint32_t> accessMemory(std::shared_ptr<Process> process, uint32_t virtualAddress, bool write);
+    void cloneAddressSpace(Process& source, Process& clone);
+    SharedMemoryStatus openSharedSegment(Process& process, const std::string& name, uint32_t bytes);
+    SharedMemoryStatus attachSharedSegment(Process& process, const std::string& name, uint32_t virtualAddress);
+    std::optional<uint32_t> accessMemory(Process& process, uint32_t virtualAddress, bool write);
+    std::optional<uint16_t> readVirtual(Process& process, uint32_t virtualAddress);
+    bool writeVirtual(Process& process, uint32_t virtualAddress, uint16_t value);
+
+    void registerTLB(int coreId, TLB* tlb);
+    void unregisterTLB(int coreId);
 
     uint16_t readUint16At(uint32_t physicalAddress);
     void writeUint16At(uint32_t physicalAddress, uint16_t value);
@@ -41,21 +122,116 @@ public:
     uint32_t getFrameSize() const { return frameSize; }
     uint32_t getTotalFrames() const { return totalFrames; }
     const std::vector<PageFrame>& getFrameTable() const { return frameTable; }
+    uint32_t getFreeFrameCount() const;
+    uint32_t getResidentFrameCount(uint32_t pid) const;
     uint32_t getPagesPagedIn() const { return pagesPagedIn; }
     uint32_t getPagesPagedOut() const { return pagesPagedOut; }
+    uint64_t getZeroFillFaults() const { return zeroFillFaults; }
+    uint64_t getZeroPagesDeduplicated() const { return zeroPagesDeduplicated; }
+    size_t getUsedSwapSlots() const { return backingStore->getUsedSlots(); }
+    size_t getSwapFileCount() const { return backingStore->getFileCount(); }
+    const CompressedPageCache& getCompressedCache() const { return *compressedCache; }
+    const SwapIoQueue& getSwapIoQueue() const { return *swapIo; }
+    uint64_t getPagesPrefetched() const { return pagesPrefetched; }
+    uint64_t getPrefetchHits() const { return prefetchHits; }
+    uint64_t getPrefetchMisses() const { return prefetchMisses; }
+    uint64_t getPageFaults() const { return pageFaults; }
+    uint64_t getHugePageFaults() const { return hugePageFaults; }
+    bool isHugeFramesEnabled() const { return hugeFramesEnabled; }
+    uint32_t getHugeFrameCount() const { return frameAllocator.getHugeFrameCount(); }
+    uint32_t getFreeHugeFrameCount() const;
+
+    void sampleWorkingSets();
+    uint32_t compactMemory();
+    void compactIfFragmented();
+    double getFragmentation() const;
+    uint64_t getCompactions() const { return compactions; }
+    uint64_t getPagesMigrated() const { return pagesMigrated; }
+    bool workingSetFits(Process& process) const;
+    uint32_t getWorkingSetSize(uint32_t pid) const;
+    size_t getTotalWorkingSet() const;
+    uint64_t getAdmissionsDenied() const { return admissionsDenied; }
+    uint64_t getLocalReplacements() const { return localReplacements; }
+    uint64_t getPagesShared() const { return pagesShared; }
+    uint64_t getCopyOnWriteFaults() const { return copyOnWriteFaults; }
+    size_t getSharedSegmentCount() const;
+    uint32_t getPinnedFrameCount() const;
+    std::string getReplacementPolicyName() const { return replacementPolicy->getName(); }
+
+    size_t getWriteBackQueueDepth() const;
+    size_t getWriteBackQueueCapacity() const { return WRITEBACK_QUEUE_CAPACITY; }
+    uint64_t getPagesWrittenBack() const { return pagesWrittenBack; }
+    uint64_t getSyncWriteBacks() const { return syncWriteBacks; }
+    double getAverageWriteBackLatencyMs() const;
+
+    uint64_t getTLBHits() const { return tlbHits; }
+    uint64_t getTLBMisses() const { return tlbMisses; }
+
+    void shutdown();
 
     void freeProcessPages(uint32_t pid);
-    bool canUnblock(std::shared_ptr<Process> process);
-    void tryUnblockingBlockedProcesses();
+    size_t getMemoryWaitQueueDepth() const;
+
+    uint32_t writeCheckpoint(CheckpointWriter& out, const std::vector<std::shared_ptr<Process>>& processes,
+                             bool incremental, const std::unordered_set<int>& checkpointedPids);
+    void readCheckpoint(CheckpointReader& in, MemoryImage& image,
+                        const std::unordered_map<uint32_t, std::shared_ptr<Process>>& processByPid);
+    void restoreCheckpoint(MemoryImage& image, const std::vector<std::shared_ptr<Process>>& processes,
+                           const std::vector<std::shared_ptr<Process>>& registered);
 
 private:
     MemoryManager(const SystemConfig& config);
 
-    int findFreeFrame();
-    void evictPage();
-    void loadPage(std::shared_ptr<Process> process, uint32_t vpn, uint32_t frameNumber);
-    void savePageToBackingStore(uint32_t pid, uint32_t vpn, uint32_t frameNumber);
+    std::optional<uint32_t> translateResident(Process& process, uint32_t virtualAddress, bool write);
+    std::optional<uint32_t> translateAddress(Process& process, uint32_t virtualAddress, bool write,
+                                             std::unique_lock<std::shared_mutex>& lock);
+    std::optional<uint32_t> allocateFrame();
+    void releaseFrame(uint32_t frameNumber);
+    bool mapHugeFrame(Process& process, uint32_t vpn);
+    void demoteHugeFrame(uint32_t frameNumber);
+    uint32_t trackedFrame(uint32_t frameNumber) const;
+    uint32_t mappedFrameCount(uint32_t frameNumber) const;
+    uint32_t compactFrames();
+    bool isMovableFrame(uint32_t frameNumber) const;
+    void migrateFrame(uint32_t from, uint32_t to);
+    double fragmentation() const;
+    size_t residentCount(uint32_t pid) const;
+    void removeResidentFrame(uint32_t pid, uint32_t frameNumber);
+    bool evictPage();
+    void evictOwnPage(Process& process);
+    void evictFrame(uint32_t frameNumber);
+    void unmapPage(uint32_t pid, uint32_t vpn);
+    void detachSharer(uint32_t frameNumber, uint32_t pid);
+    bool breakCopyOnWrite(Process& process, uint32_t vpn);
+    bool readStoredPage(uint32_t pid, uint32_t vpn, uint8_t* dest);
+    void discardMapping(Process& process, uint32_t vpn);
+    void unmapSharedFrame(uint32_t pid, uint32_t frameNumber);
+    void releaseUnusedSharedSegments();
+    size_t frameQuota(Process& process) const;
+    size_t admissionEstimate(Process& process) const;
+    bool admitProcess(Process& process);
+    void recomputeWorkingSets();
+    TLB* tlbFor(const Process& process) const;
+    void shootDownTLBs(uint32_t pid, uint32_t vpn);
+    void blockOnMemory(Process& process);
+    void terminateOnViolation(Process& process, uint32_t virtualAddress);
+    void readAheadAfterFault(Process& process, uint32_t vpn);
+    std::vector<std::shared_ptr<Process>> wakeMemoryWaiters();
+    void loadPage(Process& process, uint32_t vpn, uint32_t frameNumber);
     void loadPageFromBackingStore(uint32_t pid, uint32_t vpn, uint32_t frameNumber);
+    void submitSwapReads(std::unique_lock<std::shared_mutex>& lock);
+    bool isPagingIn(uint32_t frameNumber) const;
+    bool isZeroFrame(uint32_t frameNumber) const;
+    bool dropIfZeroPage(uint32_t pid, uint32_t vpn, PageTableEntry& entry);
+
+    void writeBackLoop();
+    void queueDirtyPagesForWriteBack();
+    bool enqueueWriteBack(uint32_t pid, uint32_t vpn, uint32_t frameNumber);
+    bool readFromWriteBackQueue(uint32_t pid, uint32_t vpn, uint8_t* dest);
+    void drainWriteBackQueue(std::unique_lock<std::mutex>& lock);
+    void eraseQueuedWriteBack(uint32_t pid, uint32_t vpn, std::unique_lock<std::mutex>& lock);
+    bool compressToPool(uint32_t pid, uint32_t vpn, uint32_t frameNumber);
+    void writeBackWithQueue(uint32_t pid, uint32_t vpn, uint32_t frameNumber);
 
     std::vector<uint8_t> memory;
 
@@ -63,11 +239,93 @@ private:
     uint32_t frameSize;
     uint32_t totalFrames;
 
-    uint32_t pagesPagedIn = 0;
-    uint32_t pagesPagedOut = 0;
+    std::atomic<uint32_t> pagesPagedIn = 0;
+    std::atomic<uint32_t> pagesPagedOut = 0;
+    std::atomic<uint64_t> zeroFillFaults = 0;           // Faults on demand-zero pages, served without I/O
+    std::atomic<uint64_t> zeroPagesDeduplicated = 0;    // Dirty all-zero pages dropped instead of written out
 
     std::vector<PageFrame> frameTable;
-    std::deque<std::pair<uint32_t, uint32_t>> fifoQueue;
+    FrameAllocator frameAllocator;              // Free frames, grouped into huge frames
+
+    // Frames whose contents were written, or that were allocated, since the last checkpoint.
+    // Atomic because cores write resident pages under the shared lock
+    std::vector<std::atomic<bool>> changedFrames;
+
+    // Huge frames: a fault maps HUGE_FRAME_PAGES aligned pages at once into one whole huge frame
+    static constexpr uint32_t HUGE_FRAME_PAGES = FrameAllocator::HUGE_FRAME_PAGES;
+    bool hugeFramesEnabled = false;
+    std::atomic<uint64_t> pageFaults = 0;               // Faults that loaded pages, huge or not
+    std::atomic<uint64_t> hugePageFaults = 0;           // Faults served with a whole huge frame
+
+    // Compaction: moves resident pages down so free frames gather into whole huge frames
+    uint32_t compactThreshold = 0;                      // Fragmentation (percent) that triggers it, 0 = never
+    std::atomic<uint64_t> compactions = 0;
+    std::atomic<uint64_t> pagesMigrated = 0;
+
+    // Reverse map pid -> frames holding its pages; the set size is the process's resident count
+    std::unordered_map<uint32_t, std::unordered_set<uint32_t>> residentFrames;
+    std::unique_ptr<PageReplacementPolicy> replacementPolicy;
+
+    std::unique_ptr<SwapDirectory> backingStore;
+    std::unique_ptr<SwapIoQueue> swapIo;                    // Every swap read and write goes through it
+    std::vector<SwapIoRequest> pendingSwapReads;            // Reads of the fault being handled (guarded by memoryMutex)
+    std::unique_ptr<CompressedPageCache> compressedCache;   // zswap-like pool tried before the backing store
+
+    // Read-ahead on sequential faults, keyed by pid
+    static constexpr uint32_t READAHEAD_MIN_WINDOW = 1;
+    static constexpr uint32_t READAHEAD_MAX_WINDOW = 8;
+    std::unordered_map<uint32_t, ReadAheadState> readAheadStates;
+    std::atomic<uint64_t> pagesPrefetched = 0;
+    std::atomic<uint64_t> prefetchHits = 0;             // Read-ahead pages accessed before eviction
+    std::atomic<uint64_t> prefetchMisses = 0;           // Read-ahead pages evicted without being accessed
+
+    // Working sets from sampled reference bits; quotas and admission follow them
+    static constexpr uint8_t WS_WINDOW_MASK = 0xF0;     // Working-set window: the last 4 sampled ticks
+    static constexpr size_t WS_INITIAL_ESTIMATE = 2;    // Working set assumed before the first sample
+    static constexpr size_t WS_QUOTA_SLACK = 1;         // Frames allowed beyond the working set
+    std::unordered_map<uint32_t, uint32_t> workingSetSizes;
+    size_t totalWorkingSet = 0;                         // Sum over processes with resident pages
+    std::atomic<uint64_t> admissionsDenied = 0;
+    std::atomic<uint64_t> localReplacements = 0;
+
+    // Copy-on-write sharing between a process and its clones
+    std::atomic<uint64_t> pagesShared = 0;              // Resident pages mapped into a clone instead of copied
+    std::atomic<uint64_t> copyOnWriteFaults = 0;        // Writes that had to copy a shared frame
+
+    // Shared-memory segments by name. Their frames are pinned: the replacement policy never sees them
+    static constexpr uint32_t SHM_MAX_PINNED_PERCENT = 50;  // Share of the frames segments may pin
+    std::unordered_map<std::string, SharedSegment> sharedSegments;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> sharedMappings;    // pid -> segment frames it maps
+    uint32_t pinnedFrames = 0;
+
+    // Processes blocked on a page fault, oldest first; woken one per freed frame
+    std::deque<std::shared_ptr<Process>> memoryWaitQueue;
+
+    // Guards frames, page tables, the replacement policy and the TLBs. Accesses to resident
+    // pages take it shared so cores translate in parallel; faults, evictions, frees and the
+    // write-back daemon's scan take it exclusively, so their bookkeeping is still serialized
+    // across cores. Only a fault's swap reads run with it released (see submitSwapReads).
+    // Lock order: memoryMutex, then writeBackMutex.
+    mutable std::shared_mutex memoryMutex;
+
+    // Per-core translation caches indexed by core id (nullptr for cores that are not running)
+    std::vector<TLB*> tlbs;
+    std::atomic<uint64_t> tlbHits = 0;
+    std::atomic<uint64_t> tlbMisses = 0;
+
+    // Write-back daemon: cleans dirty pages the replacement policy will evict next
+    static constexpr size_t WRITEBACK_QUEUE_CAPACITY = 32;
+    std::thread writeBackThread;
+    std::atomic<bool> writeBackRunning = false;
+    std::deque<WriteBackRequest> writeBackQueue;        // Bounded, oldest request at the front
+    std::vector<WriteBackRequest> writeBackInFlight;    // Batch being written, still readable by page-ins
+    mutable std::mutex writeBackMutex;                  // Not held during the batch's I/O
+    std::condition_variable writeBackCv;
+    std::condition_variable writeBackDone;              // writeBackInFlight emptied
+
+    std::atomic<uint64_t> pagesWrittenBack = 0;         // Pages cleaned by the daemon
+    std::atomic<uint64_t> syncWriteBacks = 0;           // Dirty evictions that had to write synchronously
+    std::atomic<uint64_t> totalWriteBackLatencyUs = 0;  // Enqueue-to-disk time of all daemon writes
 
     static std::shared_ptr<MemoryManager> instance;
 };
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "PageReplacementPolicy.h"
+#include "FIFOPolicy.h"
+#include "SecondChancePolicy.h"
+#include "ClockPolicy.h"
+#include "LRUPolicy.h"
+#include "LFUPolicy.h"
+
+// Factory for the policy selected by the "page-replacement" config key
+std::unique_ptr<PageReplacementPolicy> PageReplacementPolicy::create(const std::string& name, uint32_t totalFrames) {
+    if (name == "clock") return std::make_unique<ClockPolicy>(totalFrames);
+    if (name == "second-chance") return std::make_unique<SecondChancePolicy>();
+    if (name == "lru") return std::make_unique<LRUPolicy>(totalFrames);
+    if (name == "lfu") return std::make_unique<LFUPolicy>(totalFrames);
+    return std::make_unique<FIFOPolicy>();
+}
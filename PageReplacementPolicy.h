@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Callback used by policies to read and clear the referenced bit of the page held in a frame.
+ *
+ * Returns true if the page was referenced since the last probe.
+ */
+using ReferenceProbe = std::function<bool(uint32_t frameNumber)>;
+
+/**
+ * @class PageReplacementPolicy
+ * @brief Interface for choosing which resident frame the MemoryManager evicts.
+ *
+ * Policies track frames (not pages) and are notified whenever a frame is filled,
+ * accessed or freed. The policy used is selected with the "page-replacement" key
+ * in config.txt.
+ */
+class PageReplacementPolicy {
+public:
+    virtual ~PageReplacementPolicy() = default;
+
+    /**
+     * @brief Creates the policy with the given name ("fifo", "clock", "second-chance", "lru" or "lfu").
+     * @param name        Policy name from config.txt.
+     * @param totalFrames Number of physical frames.
+     */
+    static std::unique_ptr<PageReplacementPolicy> create(const std::string& name, uint32_t totalFrames);
+
+    /**
+     * @brief Called after a page has been loaded into a frame.
+     */
+    virtual void onPageLoaded(uint32_t frameNumber) = 0;
+
+    /**
+     * @brief Called on every access to a resident page.
+     */
+    virtual void onPageAccessed(uint32_t /*frameNumber*/) {}
+
+    /**
+     * @brief Called when a frame is released without going through selectVictim().
+     */
+    virtual void onFrameFreed(uint32_t frameNumber) = 0;
+
+    /**
+     * @brief Called when compaction moves a page to another frame. The page keeps its
+     *        place (age, access history) under its new frame number.
+     */
+    virtual void onFrameMoved(uint32_t from, uint32_t to) = 0;
+
+    /**
+     * @brief Picks the frame to evict and stops tracking it.
+     * @param testAndClearReferenced Reads and clears the referenced bit of a frame's page.
+     * @return The victim frame, or std::nullopt if no frame is tracked.
+     */
+    virtual std::optional<uint32_t> selectVictim(const ReferenceProbe& testAndClearReferenced) = 0;
+
+    /**
+     * @brief Returns up to count frames that are likely to be evicted next, without changing any state.
+     */
+    virtual std::vector<uint32_t> peekVictims(size_t count) const = 0;
+
+    /**
+     * @brief Returns the policy name as written in config.txt.
+     */
+    virtual std::string getName() const = 0;
+};
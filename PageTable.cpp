@@ -0,0 +1,36 @@
+#include "PageTable.h"
+
+#include <algorithm>
+
+PageTable::PageTable(uint32_t pageCount)
+    : pageCount(pageCount), directory((static_cast<uint64_t>(pageCount) + ENTRIES_PER_TABLE - 1) >> TABLE_BITS) {
+}
+
+PageTableEntry& PageTable::operator[](uint32_t vpn) {
+    uint32_t tableIndex = vpn >> TABLE_BITS;
+    auto& table = directory[tableIndex];
+    if (!table)
+        table = std::make_unique<PageTableEntry[]>(tableLength(tableIndex));
+    return table[vpn & (ENTRIES_PER_TABLE - 1)];
+}
+
+PageTableEntry* PageTable::find(uint32_t vpn) {
+    if (vpn >= pageCount) return nullptr;
+
+    auto& table = directory[vpn >> TABLE_BITS];
+    return table ? &table[vpn & (ENTRIES_PER_TABLE - 1)] : nullptr;
+}
+
+size_t PageTable::getAllocatedEntries() const {
+    size_t entries = 0;
+    for (uint32_t tableIndex = 0; tableIndex < directory.size(); ++tableIndex) {
+        if (directory[tableIndex]) entries += tableLength(tableIndex);
+    }
+    return entries;
+}
+
+// Second-level tables hold ENTRIES_PER_TABLE entries, except the last one, which stops at pageCount
+uint32_t PageTable::tableLength(uint32_t tableIndex) const {
+    uint32_t firstVpn = tableIndex << TABLE_BITS;
+    return std::min(ENTRIES_PER_TABLE, pageCount - firstVpn);
+}
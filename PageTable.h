@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct PageTableEntry {
+    bool valid = false;
+    bool dirty = false;
+    bool referenced = false;    // Set on every access, cleared by CLOCK/second-chance sweeps
+    bool zeroPage = true;       // Page content is all zeros and has no backing store slot (demand-zero)
+    bool prefetched = false;    // Loaded by read-ahead and not accessed since
+    bool wsReferenced = false;  // Accessed since the last working-set sample
+    bool copyOnWrite = false;   // Frame is shared with a clone; the first write copies it
+    bool sharedMemory = false;  // Maps a frame of a shared-memory segment, which is never evicted
+    bool checkpointDirty = false;   // Mapping changed since the last checkpoint (access bits do not count)
+    uint8_t referenceHistory = 0;   // One bit per sampled tick, most recent in the top bit
+    uint32_t frameNumber = 0;
+};
+
+/**
+ * @class PageTable
+ * @brief Two-level sparse page table for a 32-bit virtual page number space.
+ *
+ * The first level is a directory with one slot per ENTRIES_PER_TABLE pages. A second-level
+ * table is only allocated the first time one of its pages is touched through operator[], so
+ * a large address space costs memory only for the regions the process actually uses. Pages
+ * in tables that were never allocated read as default entries (not valid, demand-zero).
+ *
+ * Second-level tables are never moved or freed while the page table exists, so the
+ * PageTableEntry pointers cached by the TLB stay valid.
+ */
+class PageTable {
+public:
+    static constexpr uint32_t TABLE_BITS = 8;
+    static constexpr uint32_t ENTRIES_PER_TABLE = 1u << TABLE_BITS;
+
+    PageTable() = default;
+
+    /**
+     * @brief Creates an empty table covering pages [0, pageCount). Nothing is allocated
+     *        besides the directory.
+     */
+    explicit PageTable(uint32_t pageCount);
+
+    uint32_t size() const { return pageCount; }
+    bool empty() const { return pageCount == 0; }
+
+    /**
+     * @brief Returns the entry of a page, allocating its second-level table on first touch.
+     * @param vpn Virtual page number, must be below size().
+     */
+    PageTableEntry& operator[](uint32_t vpn);
+
+    /**
+     * @brief Returns the entry of a page without allocating, or nullptr if its
+     *        second-level table was never touched (or vpn is out of range).
+     */
+    PageTableEntry* find(uint32_t vpn);
+
+    /**
+     * @brief Calls visit(vpn, entry) for every entry of every allocated second-level table.
+     */
+    template <typename Visitor>
+    void forEachAllocated(Visitor&& visit) {
+        for (uint32_t tableIndex = 0; tableIndex < directory.size(); ++tableIndex) {
+            if (!directory[tableIndex]) continue;
+
+            uint32_t firstVpn = tableIndex << TABLE_BITS;
+            for (uint32_t i = 0; i < tableLength(tableIndex); ++i)
+                visit(firstVpn + i, directory[tableIndex][i]);
+        }
+    }
+
+    /**
+     * @brief Returns the number of entries held by allocated second-level tables.
+     */
+    size_t getAllocatedEntries() const;
+
+private:
+    uint32_t tableLength(uint32_t tableIndex) const;
+
+    uint32_t pageCount = 0;
+    std::vector<std::unique_ptr<PageTableEntry[]>> directory;   // nullptr for untouched regions
+};
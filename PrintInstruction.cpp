@@ -61,3 +61,15 @@ int PrintInstruction::execute(Process& process) {
 std::string PrintInstruction::toString() const {
     return "PRINT (" + data + ")";
 }
+
+std::string PrintInstruction::toSource() const {
+    switch (type) {
+        case PrintType::Hello:
+            return "PRINT (\"Hello\")";
+        case PrintType::Literal:
+            return "PRINT (\"" + data + "\")";
+        default:
+            // Variables and expressions are kept exactly as they were parsed
+            return "PRINT (" + data + ")";
+    }
+}
@@ -56,6 +56,16 @@ public:
      */
     std::string toString() const override;
 
+
+
+
+    /**
+     * @brief Returns the instruction in the syntax Instruction::fromString parses.
+     *
+     * @return std::string e.g., "PRINT (\"text\")" or "PRINT (x)".
+     */
+    std::string toSource() const override;
+
 private:
     PrintType type;     // Kind of print to perform
     std::string data;   // Literal or variable name
@@ -3,21 +3,38 @@
 #include <ctime>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 #include "Process.h"
+#include "CheckpointStream.h"
 #include "ConsoleUtil.h"
 
 #include "Instruction.h"
 
 std::atomic<int> Process::nextPID{0};
 std::unordered_map<uint32_t, std::shared_ptr<Process>> Process::pidToProcess;
+std::mutex Process::registryMutex;
 
-Process::Process(const std::string& name, std::vector<std::shared_ptr<Instruction>> instructions, uint16_t mem, uint16_t pages)
+Process::Process(const std::string& name, std::vector<std::shared_ptr<Instruction>> instructions, uint32_t mem, uint32_t pages)
     : name(name), instructions(std::move(instructions)), memoryRequired(mem), pageCount(pages) {
     pid = nextPID.fetch_add(1);
     creationTime = generateCreationTimestamp();
 }
 
+// Creates a process that shares this one's instructions and continues from the same instruction
+// with a copy of its variables. Its memory is set up by MemoryManager::cloneAddressSpace.
+// The caller pauses the cores around both calls so the instruction index, variables and
+// memory are copied at the same instant
+std::shared_ptr<Process> Process::cloneAs(const std::string& cloneName) const {
+    auto clone = std::make_shared<Process>(cloneName, instructions, memoryRequired, pageCount);
+    {
+        std::lock_guard<std::mutex> lock(symbolTableMutex);
+        clone->symbolTable = symbolTable;
+    }
+    clone->currentInstructionIndex = currentInstructionIndex;
+    return clone;
+}
+
 std::string Process::getName() const { return name; }
 int Process::getPID() const { return pid; }
 int Process::peakNextPID() { return nextPID.load(); }
@@ -27,7 +44,10 @@ void Process::setCoreID(int id) { coreID = id; }
 unsigned long Process::getDelayCounter() const { return delayCounter; }
 
 ProcessState Process::getState() const { return state; }
-void Process::setState(ProcessState s) { state = s; }
+void Process::setState(ProcessState s) {
+    state = s;
+    ++version;
+}
 
 size_t Process::getCurrentInstructionIndex() const { return currentInstructionIndex; }
 size_t Process::getRemainingInstruction() const { return instructions.size() - currentInstructionIndex; }
@@ -35,6 +55,7 @@ size_t Process::getTotalInstructions() const { return instructions.size(); }
 
 void Process::executeInstruction(int delayPerExec) {
     if (getRemainingInstruction() == 0) return;
+    ++version;
 
     if (delayCounter > 0) {
         setState(ProcessState::Sleeping);
@@ -54,6 +75,9 @@ void Process::executeInstruction(int delayPerExec) {
 
     if (state == ProcessState::Terminated) return;
 
+    // A READ/WRITE that blocked on memory is retried once the process is woken
+    if (state == ProcessState::Blocked) return;
+
     if (instr->isComplete(pid)) {
         currentInstructionIndex++;
     }
@@ -62,8 +86,10 @@ void Process::executeInstruction(int delayPerExec) {
 }
 
 void Process::tick() {
-    if (delayCounter > 0)
+    if (delayCounter > 0) {
         delayCounter--;
+        ++version;
+    }
 }
 
 bool Process::isFinished() const {
@@ -82,6 +108,7 @@ std::vector<ProcessLogEntry> Process::getLogs() const {
 void Process::addLog(const ProcessLogEntry& entry) {
     std::lock_guard<std::mutex> lock(logMutex);
     logEntries.push_back(entry);
+    ++version;
 }
 
 std::string Process::generateCreationTimestamp() const {
@@ -89,6 +116,7 @@ std::string Process::generateCreationTimestamp() const {
 }
 
 uint16_t Process::getVariable(const std::string& var) {
+    std::lock_guard<std::mutex> lock(symbolTableMutex);
     auto it = symbolTable.find(var);
     if (it == symbolTable.end()) return 0;
     return it->second;
@@ -96,13 +124,16 @@ uint16_t Process::getVariable(const std::string& var) {
 
 void Process::setVariable(const std::string& var, uint16_t value) {
     if (!hasMinimumMemoryForVariables()) return;
+    std::lock_guard<std::mutex> lock(symbolTableMutex);
     if (symbolTable.find(var) == symbolTable.end()) {
         if (symbolTable.size() >= SYMBOL_TABLE_MAX_VARS) return;
     }
     symbolTable[var] = std::clamp<uint32_t>(value, 0, UINT16_MAX);
+    ++version;
 }
 
 bool Process::canDeclareVariable() const {
+    std::lock_guard<std::mutex> lock(symbolTableMutex);
     return hasMinimumMemoryForVariables() && symbolTable.size() < SYMBOL_TABLE_MAX_VARS;
 }
 
@@ -112,6 +143,7 @@ uint32_t Process::getMemoryRequired() const {
 
 void Process::setMemoryRequired(uint32_t bytes) {
     memoryRequired = bytes;
+    ++version;
 }
 
 bool Process::hasMinimumMemoryForVariables() const {
@@ -124,13 +156,14 @@ uint32_t Process::getPageCount() const {
 
 void Process::setPageCount(uint32_t count) {
     pageCount = count;
+    ++version;
 }
 
 void Process::initPageTable(uint32_t pageCount) {
-    pageTable.resize(pageCount); 
+    pageTable = PageTable(pageCount);
 }
 
-std::vector<PageTableEntry>& Process::getPageTable() {
+PageTable& Process::getPageTable() {
     return pageTable;
 }
 
@@ -138,6 +171,7 @@ void Process::markTerminatedByMemoryViolation(uint32_t badAddress) {
     terminatedDueToMemoryViolation = true;
     terminationTimestamp = ConsoleUtil::generateTimestamp(); 
     invalidMemoryAddress = badAddress;
+    ++version;
 }
 
 bool Process::isTerminatedByMemoryViolation() const { return terminatedDueToMemoryViolation; }
@@ -145,14 +179,156 @@ std::string Process::getTerminationTimestamp() const { return terminationTimesta
 uint32_t Process::getInvalidMemoryAddress() const { return invalidMemoryAddress; }
 
 void Process::registerProcess(std::shared_ptr<Process> process) {
+    std::lock_guard<std::mutex> lock(registryMutex);
     pidToProcess[process->getPID()] = process;
 }
 
 void Process::unregisterProcess(uint32_t pid) {
+    std::lock_guard<std::mutex> lock(registryMutex);
     pidToProcess.erase(pid);
 }
 
 std::shared_ptr<Process> Process::getProcessByPID(uint32_t pid) {
+    std::lock_guard<std::mutex> lock(registryMutex);
     auto it = pidToProcess.find(pid);
     return (it != pidToProcess.end()) ? it->second : nullptr;
-}
\ No newline at end of file
+}
+
+// Snapshot of every registered process, safe to iterate while other threads register or unregister
+std::vector<std::shared_ptr<Process>> Process::getRegisteredProcesses() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(pidToProcess.size());
+    for (const auto& [pid, process] : pidToProcess)
+        processes.push_back(process);
+    return processes;
+}
+
+// Writes everything about the process except its page table (see MemoryManager::writeCheckpoint).
+// Instructions never change, so an incremental checkpoint of a process its parent holds skips
+// them, and only the log entries after the first savedLogEntries are written. Returns the
+// number of log entries the checkpoint holds in total
+size_t Process::writeCheckpoint(CheckpointWriter& out, const std::unordered_map<const Instruction*, uint32_t>& instructionIds,
+                                bool withInstructions, size_t savedLogEntries) const {
+    out.write(static_cast<int32_t>(pid));
+    out.writeString(name);
+    out.writeString(creationTime);
+    out.write(static_cast<uint8_t>(state.load()));
+    out.write(static_cast<uint64_t>(delayCounter));
+    out.write(memoryRequired);
+    out.write(pageCount);
+    out.write(static_cast<uint64_t>(currentInstructionIndex));
+    out.write(dispatchDeferrals);
+    out.write(terminatedDueToMemoryViolation);
+    out.writeString(terminationTimestamp);
+    out.write(invalidMemoryAddress);
+
+    {
+        std::lock_guard<std::mutex> lock(symbolTableMutex);
+        out.write(static_cast<uint32_t>(symbolTable.size()));
+        for (const auto& [var, value] : symbolTable) {
+            out.writeString(var);
+            out.write(value);
+        }
+    }
+
+    out.write(withInstructions);
+    if (withInstructions) {
+        out.write(static_cast<uint32_t>(instructions.size()));
+        for (const auto& instr : instructions)
+            out.write(instructionIds.at(instr.get()));
+    }
+
+    std::lock_guard<std::mutex> lock(logMutex);
+    savedLogEntries = std::min(savedLogEntries, logEntries.size());
+    out.write(static_cast<uint32_t>(savedLogEntries));
+    out.write(static_cast<uint32_t>(logEntries.size() - savedLogEntries));
+    for (size_t i = savedLogEntries; i < logEntries.size(); ++i) {
+        out.writeString(logEntries[i].timestamp);
+        out.write(static_cast<int32_t>(logEntries[i].coreID));
+        out.writeString(logEntries[i].instruction);
+    }
+    return logEntries.size();
+}
+
+// Rebuilds a process written by writeCheckpoint with its original pid, taking what an incremental
+// checkpoint left out from the previous version of the process. A process that was on a core
+// comes back Ready and unassigned; its page table is filled in by the MemoryManager
+std::shared_ptr<Process> Process::readCheckpoint(CheckpointReader& in, const std::vector<std::shared_ptr<Instruction>>& instructionTable,
+                                                 const Process* previous) {
+    int32_t savedPid = in.read<int32_t>();
+    std::string savedName = in.readString();
+    auto process = std::make_shared<Process>(savedName, std::vector<std::shared_ptr<Instruction>>{}, 0, 0);
+    process->pid = savedPid;
+    process->creationTime = in.readString();
+
+    uint8_t savedState = in.read<uint8_t>();
+    if (savedState > static_cast<uint8_t>(ProcessState::Terminated))
+        throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+    ProcessState restoredState = static_cast<ProcessState>(savedState);
+    if (restoredState == ProcessState::Running || restoredState == ProcessState::Sleeping)
+        restoredState = ProcessState::Ready;
+    process->state = restoredState;
+
+    process->delayCounter = static_cast<unsigned long>(in.read<uint64_t>());
+    process->memoryRequired = in.read<uint32_t>();
+    process->pageCount = in.read<uint32_t>();
+    process->currentInstructionIndex = static_cast<size_t>(in.read<uint64_t>());
+    process->dispatchDeferrals = in.read<uint32_t>();
+    process->terminatedDueToMemoryViolation = in.read<bool>();
+    process->terminationTimestamp = in.readString();
+    process->invalidMemoryAddress = in.read<uint32_t>();
+
+    uint32_t variableCount = in.readCount();
+    for (uint32_t i = 0; i < variableCount; ++i) {
+        std::string var = in.readString();
+        process->symbolTable[var] = in.read<uint16_t>();
+    }
+
+    if (in.read<bool>()) {
+        uint32_t instructionCount = in.readCount(sizeof(uint32_t));
+        process->instructions.reserve(instructionCount);
+        for (uint32_t i = 0; i < instructionCount; ++i) {
+            uint32_t id = in.read<uint32_t>();
+            if (id >= instructionTable.size())
+                throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+            process->instructions.push_back(instructionTable[id]);
+        }
+    } else if (previous) {
+        process->instructions = previous->instructions;
+    } else {
+        throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+    }
+    if (process->currentInstructionIndex > process->instructions.size())
+        throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+
+    uint32_t keptLogs = in.read<uint32_t>();
+    if (keptLogs > (previous ? previous->logEntries.size() : 0))
+        throw std::runtime_error("Checkpoint file is truncated or corrupt.");
+    if (keptLogs > 0)
+        process->logEntries.assign(previous->logEntries.begin(), previous->logEntries.begin() + keptLogs);
+
+    uint32_t logCount = in.readCount();
+    process->logEntries.reserve(keptLogs + logCount);
+    for (uint32_t i = 0; i < logCount; ++i) {
+        ProcessLogEntry entry;
+        entry.timestamp = in.readString();
+        entry.coreID = in.read<int32_t>();
+        entry.instruction = in.readString();
+        process->logEntries.push_back(std::move(entry));
+    }
+
+    return process;
+}
+
+// Makes the given processes the only registered ones (used when a checkpoint is restored)
+void Process::replaceRegistry(const std::vector<std::shared_ptr<Process>>& processes) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    pidToProcess.clear();
+    for (const auto& process : processes)
+        pidToProcess[process->getPID()] = process;
+}
+
+void Process::restoreNextPID(int pid) {
+    nextPID = pid;
+}
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -10,6 +11,8 @@
 #include "MemoryManager.h"
 
 class Instruction;
+class CheckpointReader;
+class CheckpointWriter;
 
 enum class ProcessState {
     Blocked,
@@ -29,7 +32,9 @@ class Process;
 
 class Process : public std::enable_shared_from_this<Process> {
 public:
-    Process(const std::string& name, std::vector<std::shared_ptr<Instruction>> instructions, uint16_t mem, uint16_t pages);
+    Process(const std::string& name, std::vector<std::shared_ptr<Instruction>> instructions, uint32_t mem, uint32_t pages);
+
+    std::shared_ptr<Process> cloneAs(const std::string& cloneName) const;
 
     std::string getName() const; 
     int getPID() const;
@@ -66,7 +71,7 @@ public:
     void setPageCount(uint32_t count);
 
     void initPageTable(uint32_t pageCount);
-    std::vector<PageTableEntry>& getPageTable();
+    PageTable& getPageTable();
 
     void markTerminatedByMemoryViolation(uint32_t badAddress);
     
@@ -76,39 +81,62 @@ public:
 
     bool isWaitingOnPageFault() const { return waitingOnPageFault; }
     void setWaitingOnPageFault(bool waiting) { waitingOnPageFault = waiting; }
+    uint32_t getDispatchDeferrals() const { return dispatchDeferrals; }
+    void setDispatchDeferrals(uint32_t count) { dispatchDeferrals = count; ++version; }
+
+    // Bumped by every change to what a checkpoint stores for the process (page table aside),
+    // so an incremental checkpoint can skip processes whose version it has already written
+    uint64_t getVersion() const { return version; }
     static std::unordered_map<uint32_t, std::shared_ptr<Process>> pidToProcess;
 
     static void registerProcess(std::shared_ptr<Process> process);
     static void unregisterProcess(uint32_t pid);
     static std::shared_ptr<Process> getProcessByPID(uint32_t pid);
+    static std::vector<std::shared_ptr<Process>> getRegisteredProcesses();
+
+    // Checkpoint/restore. Instructions are written as indices into a table shared by every
+    // process; the page table is written by the MemoryManager. An incremental checkpoint
+    // leaves out the instructions and the log entries its parent already holds
+    const std::vector<std::shared_ptr<Instruction>>& getInstructions() const { return instructions; }
+    size_t writeCheckpoint(CheckpointWriter& out, const std::unordered_map<const Instruction*, uint32_t>& instructionIds,
+                           bool withInstructions, size_t savedLogEntries) const;
+    static std::shared_ptr<Process> readCheckpoint(CheckpointReader& in, const std::vector<std::shared_ptr<Instruction>>& instructionTable,
+                                                   const Process* previous);
+    static void replaceRegistry(const std::vector<std::shared_ptr<Process>>& processes);
+    static void restoreNextPID(int pid);
 
 private:
     std::string name;                                           
     int pid;                                                   
     static std::atomic<int> nextPID;                            
-    int coreID = -1;                                            
+    std::atomic<int> coreID = -1;                               
     std::string creationTime;                                   
     unsigned long delayCounter = 0;                            
 
-    ProcessState state = ProcessState::Ready;                   
+    std::atomic<ProcessState> state = ProcessState::Ready;      // Set by cores, the scheduler and the MemoryManager
     std::unordered_map<std::string, uint16_t> symbolTable;
+    mutable std::mutex symbolTableMutex;                        // Lets cloneAs copy the variables of a running process
     
     uint32_t memoryRequired;
     uint32_t pageCount = 0;
     static constexpr uint32_t SYMBOL_TABLE_START = 0;
     static constexpr uint32_t SYMBOL_TABLE_MAX_VARS = 32;
     static constexpr uint32_t SYMBOL_TABLE_BYTES = 64;
-    std::vector<PageTableEntry> pageTable;
+    PageTable pageTable;                                        // Sparse: second-level tables allocated on touch
     bool waitingOnPageFault = false;
+    uint32_t dispatchDeferrals = 0;                             // Times the scheduler skipped it for lack of memory
 
     std::vector<std::shared_ptr<Instruction>> instructions;     
     size_t currentInstructionIndex = 0;                         
+    std::atomic<uint64_t> version = 0;
 
     mutable std::mutex logMutex;                                
     std::vector<ProcessLogEntry> logEntries;     
     
     std::string generateCreationTimestamp() const;
 
+    static std::mutex registryMutex;                            // Guards pidToProcess
+
     bool terminatedDueToMemoryViolation = false;
     std::string terminationTimestamp;
     uint32_t invalidMemoryAddress = 0;
@@ -52,6 +52,12 @@ void RRScheduler::addProcess(std::shared_ptr<Process> process) {
     }
 }
 
+// Re-adds a process that is already tracked in allProcesses, such as one woken after waiting for memory
+void RRScheduler::requeueProcess(std::shared_ptr<Process> process) {
+    addToQueue(process);
+    cvReadyQueue.notify_one();
+}
+
 void RRScheduler::schedulerLoop() {
     while (!shutdownFlag) {
         {
@@ -66,18 +72,30 @@ void RRScheduler::schedulerLoop() {
 
 		if (shutdownFlag) break;
 
+        // A checkpoint holds this while it pauses the cores and copies the system
+        std::lock_guard<std::mutex> tickLock(tickMutex);
+
+        // One working-set sample per scheduler tick, then compaction if memory is fragmented
+        MemoryManager::getInstance()->sampleWorkingSets();
+        MemoryManager::getInstance()->compactIfFragmented();
+
         for (auto& core : cores) {
             auto process = core->getCurrentProcess();
 
             if (process) {
-                if (process->getRemainingInstruction() == 0) {
+                if (process->getRemainingInstruction() == 0 || process->isTerminated()) {
                     core->clearProcess();
-                    process->setState(ProcessState::Finished);
+                    if (!process->isTerminated())
+                        process->setState(ProcessState::Finished);
 
+                    // Finished or terminated, its frames and swap file are released before it is unregistered
                     MemoryManager::getInstance()->freeProcessPages(process->getPID());
 
                     Process::unregisterProcess(process->getPID());
                 }
+                else if (core->releaseBlockedProcess()) {
+                    // Blocked on memory: the MemoryManager requeues it once a frame is freed
+                }
                 else if (core->getRunTime() >= quantumCycles) {
                     auto preempted = core->preemptProcess();
                     if (preempted) {
@@ -97,12 +115,24 @@ void RRScheduler::schedulerLoop() {
                 for (auto it = readyQueue.begin(); it != readyQueue.end();) {
                     auto proc = *it;
 
-                    if (proc->getState() == ProcessState::Blocked || proc->isTerminated()) {
+                    // Drop stale entries: blocked, terminated, or already running on a core
+                    if (proc->getState() == ProcessState::Blocked || proc->isTerminated() || proc->getCoreID() != -1) {
                         it = readyQueue.erase(it);  
                         continue;
                     }
 
                     if (proc->getState() == ProcessState::Ready) {
+                        // Leave it queued while its working set cannot fit; it would only fault and block.
+                        // After MAX_DISPATCH_DEFERRALS attempts it is dispatched anyway so it cannot starve
+                        if (proc->getDispatchDeferrals() < MAX_DISPATCH_DEFERRALS &&
+                            !MemoryManager::getInstance()->workingSetFits(*proc)) {
+                            proc->setDispatchDeferrals(proc->getDispatchDeferrals() + 1);
+                            GlobalScheduler::getInstance()->incrementDeferredDispatches();
+                            ++it;
+                            continue;
+                        }
+
+                        proc->setDispatchDeferrals(0);
                         nextProcess = proc;
                         it = readyQueue.erase(it);
                         break;
@@ -162,6 +192,43 @@ bool RRScheduler::noProcessFinished() {
     return true;
 }
 
+// Stops scheduling at a tick boundary, then waits for every core to finish its instruction
+void RRScheduler::pause() {
+    pauseLock = std::unique_lock<std::mutex>(tickMutex);
+    for (auto& core : cores)
+        core->pause();
+}
+
+void RRScheduler::resume() {
+    for (auto& core : cores)
+        core->resume();
+    pauseLock.unlock();
+}
+
+std::vector<std::shared_ptr<Process>> RRScheduler::getReadyQueue() const {
+    std::lock_guard<std::mutex> lock(readyQueueMutex);
+    return readyQueue;
+}
+
+// Swaps in the processes of a restored checkpoint (scheduler paused). Cores are emptied and
+// the ready processes are dispatched from the next tick on
+void RRScheduler::replaceProcesses(std::vector<std::shared_ptr<Process>> processes, std::vector<std::shared_ptr<Process>> ready) {
+    for (auto& core : cores) {
+        if (core->getCurrentProcess())
+            core->clearProcess();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(allProcessesMutex);
+        allProcesses = std::move(processes);
+    }
+    {
+        std::lock_guard<std::mutex> lock(readyQueueMutex);
+        readyQueue = std::move(ready);
+    }
+    cvReadyQueue.notify_one();
+}
+
 std::vector<Core*> RRScheduler::getCores() const {
     std::vector<Core*> list;
     list.reserve(cores.size());
@@ -22,6 +22,7 @@ public:
     void stop();
 
     void addProcess(std::shared_ptr<Process> process);
+    void requeueProcess(std::shared_ptr<Process> process);
     std::vector<std::shared_ptr<Process>> getAllProcesses() const;
 
     bool allCoresFree();
@@ -29,6 +30,11 @@ public:
 
     std::vector<Core*> getCores() const;
 
+    void pause();
+    void resume();
+    std::vector<std::shared_ptr<Process>> getReadyQueue() const;
+    void replaceProcesses(std::vector<std::shared_ptr<Process>> processes, std::vector<std::shared_ptr<Process>> ready);
+
 private:
     void schedulerLoop();
     void addToQueue(std::shared_ptr<Process> process);
@@ -44,6 +50,9 @@ private:
     mutable std::mutex allProcessesMutex;       
     std::condition_variable cvReadyQueue;       
 
+    std::mutex tickMutex;                       // Held for each scheduler tick
+    std::unique_lock<std::mutex> pauseLock;     // Holds tickMutex between pause() and resume()
+
     int numCores;           
     int delaysPerExec;     
     int quantumCycles;     
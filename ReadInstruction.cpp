@@ -7,7 +7,7 @@
 #include <iomanip>
 
 // Constructor for ReadInstruction, initializes target variable and address (can be variable name or direct address)
-ReadInstruction::ReadInstruction(const std::string& targetVar, std::variant<std::string, uint16_t> addr)
+ReadInstruction::ReadInstruction(const std::string& targetVar, std::variant<std::string, uint32_t> addr)
     : target(targetVar), address(addr) {}
 
 // Executes the read instruction for the given process
@@ -18,27 +18,25 @@ int ReadInstruction::execute(Process& process) {
     if (std::holds_alternative<std::string>(address)) {
         virtualAddress = process.getVariable(std::get<std::string>(address));
     } else {
-        virtualAddress = std::get<uint16_t>(address);
+        virtualAddress = std::get<uint32_t>(address);
     }
 
     // Check for memory violation (address out of bounds)
-    if (virtualAddress + 1 >= process.getMemoryRequired()) {
+    if (static_cast<uint64_t>(virtualAddress) + 1 >= process.getMemoryRequired()) {
+        // The scheduler frees its memory and unregisters it
         process.markTerminatedByMemoryViolation(virtualAddress);
         process.setState(ProcessState::Terminated);
-        Process::unregisterProcess(process.getPID());
         return -1;
     }
 
-    // Try to access memory (returns optional physical address)
-    auto physicalAddrOpt = MemoryManager::getInstance()->accessMemory(process.shared_from_this(), virtualAddress, false);
-    if (!physicalAddrOpt.has_value()) {
-        // If memory access fails, block the process
-        process.setState(ProcessState::Blocked);
+    // Translate the address and read the 16-bit value in one step. On failure the MemoryManager
+    // has already blocked the process (it is retried once woken) or terminated it; setting the
+    // state here as well could overwrite a wakeup that happened in between
+    auto valueOpt = MemoryManager::getInstance()->readVirtual(process, virtualAddress);
+    if (!valueOpt.has_value())
         return -1;
-    }
 
-    // Read 16-bit value from the resolved physical address
-    uint16_t value = MemoryManager::getInstance()->readUint16At(physicalAddrOpt.value());
+    uint16_t value = valueOpt.value();
     // Store the value in the process's variable table
     process.setVariable(target, value);
 
@@ -58,3 +56,7 @@ std::string ReadInstruction::toString() const {
     oss << "READ " << target;
     return oss.str();
 }
+
+std::string ReadInstruction::toSource() const {
+    return "READ " + target + " " + operandToSource(address);
+}
@@ -17,10 +17,17 @@ public:
     virtual void stop() = 0;
 
     virtual void addProcess(std::shared_ptr<Process> process) = 0;
+    virtual void requeueProcess(std::shared_ptr<Process> process) = 0;
     virtual std::vector<std::shared_ptr<Process>> getAllProcesses() const = 0;
 
     virtual std::vector<Core*> getCores() const = 0;
 
+    // Checkpoint/restore: pause() returns once no tick and no instruction is in progress
+    virtual void pause() = 0;
+    virtual void resume() = 0;
+    virtual std::vector<std::shared_ptr<Process>> getReadyQueue() const = 0;
+    virtual void replaceProcesses(std::vector<std::shared_ptr<Process>> processes, std::vector<std::shared_ptr<Process>> ready) = 0;
+
     virtual bool allCoresFree() = 0;
     virtual bool noProcessFinished() = 0;
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include <algorithm>
+
+#include "SecondChancePolicy.h"
+
+void SecondChancePolicy::onPageLoaded(uint32_t frameNumber) {
+    queue.push_back(frameNumber);
+}
+
+void SecondChancePolicy::onFrameFreed(uint32_t frameNumber) {
+    queue.erase(std::remove(queue.begin(), queue.end(), frameNumber), queue.end());
+}
+
+void SecondChancePolicy::onFrameMoved(uint32_t from, uint32_t to) {
+    std::replace(queue.begin(), queue.end(), from, to);
+}
+
+// Gives every referenced frame at the front a second chance; after one full pass
+// all bits are clear, so the loop ends within two passes
+std::optional<uint32_t> SecondChancePolicy::selectVictim(const ReferenceProbe& testAndClearReferenced) {
+    if (queue.empty()) return std::nullopt;
+
+    for (size_t i = 0, limit = queue.size() * 2; i < limit; ++i) {
+        uint32_t frame = queue.front();
+        queue.pop_front();
+
+        if (!testAndClearReferenced(frame))
+            return frame;
+
+        queue.push_back(frame);
+    }
+
+    uint32_t victim = queue.front();
+    queue.pop_front();
+    return victim;
+}
+
+std::vector<uint32_t> SecondChancePolicy::peekVictims(size_t count) const {
+    count = std::min(count, queue.size());
+    return std::vector<uint32_t>(queue.begin(), queue.begin() + count);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <deque>
+
+#include "PageReplacementPolicy.h"
+
+/**
+ * @class SecondChancePolicy
+ * @brief FIFO that moves a referenced frame to the back of the queue (clearing its bit) instead of evicting it.
+ */
+class SecondChancePolicy : public PageReplacementPolicy {
+public:
+    void onPageLoaded(uint32_t frameNumber) override;
+    void onFrameFreed(uint32_t frameNumber) override;
+    void onFrameMoved(uint32_t from, uint32_t to) override;
+    std::optional<uint32_t> selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+    std::vector<uint32_t> peekVictims(size_t count) const override;
+    std::string getName() const override { return "second-chance"; }
+
+private:
+    std::deque<uint32_t> queue;     // Oldest frame at the front
+};
@@ -0,0 +1,49 @@
+#include "ShmAttachInstruction.h"
+#include "ConsoleUtil.h"
+#include "MemoryManager.h"
+
+#include <sstream>
+
+ShmAttachInstruction::ShmAttachInstruction(const std::string& name, std::variant<std::string, uint32_t> address)
+    : name(name), address(address) {
+}
+
+int ShmAttachInstruction::execute(Process& process) {
+    // Resolve address: if string, get variable value; else use uint32_t directly
+    uint32_t virtualAddress = 0;
+    if (std::holds_alternative<std::string>(address))
+        virtualAddress = process.getVariable(std::get<std::string>(address));
+    else
+        virtualAddress = std::get<uint32_t>(address);
+
+    // Check for memory violation (address out of bounds)
+    if (virtualAddress >= process.getMemoryRequired()) {
+        // The scheduler frees its memory and unregisters it
+        process.markTerminatedByMemoryViolation(virtualAddress);
+        process.setState(ProcessState::Terminated);
+        return -1;
+    }
+
+    SharedMemoryStatus status = MemoryManager::getInstance()->attachSharedSegment(process, name, virtualAddress);
+
+    // Log the result; a missing or misfitting segment is reported but does not stop the process
+    std::stringstream ss;
+    ss << "SHM_ATTACH\t" << name;
+    if (status == SharedMemoryStatus::Ok)
+        ss << " at address 0x" << std::hex << virtualAddress;
+    else if (status == SharedMemoryStatus::NoSegment)
+        ss << " failed: no such segment";
+    else
+        ss << " failed: does not fit at address 0x" << std::hex << virtualAddress;
+
+    process.addLog({ ConsoleUtil::generateTimestamp(), process.getCoreID(), ss.str() });
+    return 0;
+}
+
+std::string ShmAttachInstruction::toString() const {
+    return "SHM_ATTACH " + name;
+}
+
+std::string ShmAttachInstruction::toSource() const {
+    return "SHM_ATTACH " + name + " " + operandToSource(address);
+}
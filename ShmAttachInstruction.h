@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <variant>
+
+#include "Process.h"
+#include "Instruction.h"
+
+/**
+ * @class ShmAttachInstruction
+ * @brief Concrete Instruction that maps an open shared-memory segment into the
+ *      process's address space at a page-aligned virtual address.
+ *
+ * After attaching, READ and WRITE on those addresses go to the segment's frames,
+ * which every attached process sees. The pages previously at that address are discarded.
+ */
+class ShmAttachInstruction : public Instruction {
+public:
+    /**
+     * @brief Construct a new ShmAttachInstruction.
+     *
+     * @param name    Name of the segment.
+     * @param address Page-aligned virtual address (variable name or immediate value).
+     */
+    ShmAttachInstruction(const std::string& name, std::variant<std::string, uint32_t> address);
+
+    /**
+     * @brief Maps the segment and logs the action.
+     *
+     * @param process Reference to the executing Process.
+     * @return int    0, or -1 if the address is outside the process's memory.
+     */
+    int execute(Process& process) override;
+
+    /**
+     * @brief Returns a string representation of this instruction for logging.
+     *
+     * @return std::string "SHM_ATTACH <name>".
+     */
+    std::string toString() const override;
+
+    /**
+     * @brief Returns the instruction in the syntax Instruction::fromString parses.
+     *
+     * @return std::string "SHM_ATTACH <name> <address>".
+     */
+    std::string toSource() const override;
+
+private:
+    std::string name;                               // name of the segment
+    std::variant<std::string, uint32_t> address;    // where to map it
+};
@@ -0,0 +1,44 @@
+#include "ShmOpenInstruction.h"
+#include "ConsoleUtil.h"
+#include "MemoryManager.h"
+
+#include <sstream>
+
+ShmOpenInstruction::ShmOpenInstruction(const std::string& name, std::variant<std::string, uint32_t> size)
+    : name(name), size(size) {
+}
+
+int ShmOpenInstruction::execute(Process& process) {
+    // Resolve size: if string, get variable value; else use uint32_t directly
+    uint32_t bytes = 0;
+    if (std::holds_alternative<std::string>(size))
+        bytes = process.getVariable(std::get<std::string>(size));
+    else
+        bytes = std::get<uint32_t>(size);
+
+    SharedMemoryStatus status = MemoryManager::getInstance()->openSharedSegment(process, name, bytes);
+
+    // Not enough frames yet: the MemoryManager has already blocked the process (it is retried
+    // once woken); setting the state here as well could overwrite a wakeup that happened in between
+    if (status == SharedMemoryStatus::NoMemory)
+        return -1;
+
+    // Log the result; an invalid size is reported but does not stop the process
+    std::stringstream ss;
+    ss << "SHM_OPEN\t" << name;
+    if (status == SharedMemoryStatus::Ok)
+        ss << " (" << bytes << " bytes)";
+    else
+        ss << " failed: invalid size " << bytes;
+
+    process.addLog({ ConsoleUtil::generateTimestamp(), process.getCoreID(), ss.str() });
+    return 0;
+}
+
+std::string ShmOpenInstruction::toString() const {
+    return "SHM_OPEN " + name;
+}
+
+std::string ShmOpenInstruction::toSource() const {
+    return "SHM_OPEN " + name + " " + operandToSource(size);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <variant>
+
+#include "Process.h"
+#include "Instruction.h"
+
+/**
+ * @class ShmOpenInstruction
+ * @brief Concrete Instruction that opens a named shared-memory segment,
+ *      creating it with the given size if no process has opened it yet.
+ *
+ * The segment's frames are pinned in physical memory until every process that
+ * opened or attached it has finished. Use SHM_ATTACH to map it into the process.
+ */
+class ShmOpenInstruction : public Instruction {
+public:
+    /**
+     * @brief Construct a new ShmOpenInstruction.
+     *
+     * @param name Name of the segment.
+     * @param size Size in bytes (variable name or immediate value); ignored if the segment exists.
+     */
+    ShmOpenInstruction(const std::string& name, std::variant<std::string, uint32_t> size);
+
+    /**
+     * @brief Opens or creates the segment and logs the action.
+     *
+     * @param process Reference to the executing Process.
+     * @return int    0, or -1 if the process blocked waiting for frames.
+     */
+    int execute(Process& process) override;
+
+    /**
+     * @brief Returns a string representation of this instruction for logging.
+     *
+     * @return std::string "SHM_OPEN <name>".
+     */
+    std::string toString() const override;
+
+    /**
+     * @brief Returns the instruction in the syntax Instruction::fromString parses.
+     *
+     * @return std::string "SHM_OPEN <name> <size>".
+     */
+    std::string toSource() const override;
+
+private:
+    std::string name;                           // name of the segment
+    std::variant<std::string, uint32_t> size;   // size in bytes
+};
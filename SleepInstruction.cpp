@@ -20,4 +20,8 @@ int SleepInstruction::execute(Process& process) {
 
 std::string SleepInstruction::toString() const {
     return "SLEEP " + std::to_string(ticks);
+}
+
+std::string SleepInstruction::toSource() const {
+    return "SLEEP " + std::to_string(ticks);
 }
\ No newline at end of file
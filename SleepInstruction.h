@@ -42,6 +42,16 @@ public:
      */
     std::string toString() const override;
 
+
+
+
+    /**
+     * @brief Returns the instruction in the syntax Instruction::fromString parses.
+     *
+     * @return std::string "SLEEP <ticks>".
+     */
+    std::string toSource() const override;
+
 private:
     uint8_t ticks;  // Number of ticks to sleep
 };
\ No newline at end of file
@@ -44,4 +44,8 @@ int SubtractInstruction::execute(Process& process) {
 
 std::string SubtractInstruction::toString() const {
     return "SUBTRACT " + target;
+}
+
+std::string SubtractInstruction::toSource() const {
+    return "SUBTRACT " + target + " " + operandToSource(op1) + " " + operandToSource(op2);
 }
\ No newline at end of file
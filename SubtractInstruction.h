@@ -51,6 +51,16 @@ public:
      */
     std::string toString() const override;
 
+
+
+
+    /**
+     * @brief Returns the instruction in the syntax Instruction::fromString parses.
+     *
+     * @return std::string "SUBTRACT <target> <op1> <op2>".
+     */
+    std::string toSource() const override;
+
 private:
     std::string target;                             // target variable name
     std::variant<std::string, uint16_t> op1, op2;   // operands
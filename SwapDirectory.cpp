@@ -0,0 +1,265 @@
+#include "SwapDirectory.h"
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+
+SwapDirectory::SwapDirectory(const std::string& mode, const std::string& directory, uint32_t pageSize)
+    : mode(mode), directory(directory), pageSize(pageSize) {
+    std::filesystem::create_directories(directory);
+
+    // Slot indexes live in memory only, so files from a previous run are unreadable leftovers
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("process-", 0) == 0 && entry.path().extension() == ".swap")
+            std::filesystem::remove(entry.path(), ec);
+    }
+
+    for (size_t i = 1; i < MAX_IO_THREADS; ++i)
+        workers.emplace_back(&SwapDirectory::workerLoop, this);
+}
+
+SwapDirectory::~SwapDirectory() {
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+
+    releaseAll();
+}
+
+// Closes the file before unlinking it (an open file cannot be deleted on Windows)
+SwapDirectory::SwapFile::~SwapFile() {
+    store.reset();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+// Runs work(0) .. work(count - 1) split into up to MAX_IO_THREADS shares, one on the calling
+// thread and the others on the I/O workers, and returns the sum of their results. Throws the
+// first error of any share once every share is done, so none is left using the caller's data
+size_t SwapDirectory::runInParallel(size_t count, const std::function<size_t(size_t)>& work) {
+    const size_t shares = std::min(count, MAX_IO_THREADS);
+    auto runShare = [&](size_t first) {
+        size_t total = 0;
+        for (size_t i = first; i < count; i += shares)
+            total += work(i);
+        return total;
+    };
+
+    size_t total = 0;
+    size_t remaining = shares;
+    std::exception_ptr error;
+    auto finishShare = [&](size_t shareTotal, std::exception_ptr shareError) {
+        std::lock_guard<std::mutex> lock(workMutex);
+        total += shareTotal;
+        if (shareError && !error) error = shareError;
+        if (--remaining == 0) workDone.notify_all();
+    };
+    auto runAndFinish = [&](size_t share) {
+        size_t shareTotal = 0;
+        std::exception_ptr shareError;
+        try {
+            shareTotal = runShare(share);
+        } catch (...) {
+            shareError = std::current_exception();
+        }
+        finishShare(shareTotal, shareError);
+    };
+
+    if (shares > 1) {
+        {
+            std::lock_guard<std::mutex> lock(workMutex);
+            for (size_t share = 1; share < shares; ++share)
+                tasks.push_back([&, share] { runAndFinish(share); });
+        }
+        workReady.notify_all();
+    }
+    if (shares > 0) runAndFinish(0);
+
+    std::unique_lock<std::mutex> lock(workMutex);
+    workDone.wait(lock, [&] { return remaining == 0; });
+    if (error) std::rethrow_exception(error);
+    return total;
+}
+
+// Runs queued shares until the directory is destroyed
+void SwapDirectory::workerLoop() {
+    std::unique_lock<std::mutex> lock(workMutex);
+    while (true) {
+        workReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty()) return;
+
+        auto task = std::move(tasks.front());
+        tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+// Splits the batch by process and reads each process's share from its own file
+size_t SwapDirectory::readPages(std::vector<PageRead>& pages) {
+    std::vector<std::shared_ptr<SwapFile>> shareFiles;
+    std::vector<std::vector<size_t>> shareIndexes;          // Positions in pages
+    std::unordered_map<uint32_t, size_t> shareOf;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        pages[i].found = false;
+        auto [it, added] = shareOf.emplace(pages[i].pid, shareFiles.size());
+        if (added) {
+            shareFiles.push_back(find(pages[i].pid, false));
+            shareIndexes.emplace_back();
+        }
+        shareIndexes[it->second].push_back(i);
+    }
+
+    return runInParallel(shareFiles.size(), [&](size_t share) -> size_t {
+        if (!shareFiles[share]) return 0;     // Nothing of this process was ever paged out
+
+        std::vector<PageRead> reads;
+        reads.reserve(shareIndexes[share].size());
+        for (size_t i : shareIndexes[share])
+            reads.push_back(pages[i]);
+        size_t operations = shareFiles[share]->store->readPages(reads);
+        for (size_t j = 0; j < reads.size(); ++j)
+            pages[shareIndexes[share][j]].found = reads[j].found;
+        return operations;
+    });
+}
+
+// Splits the batch by process and writes each process's share to its own file
+size_t SwapDirectory::writePages(const std::vector<PageWrite>& pages) {
+    // Keeps batch order within a process, so a page queued twice keeps its newest copy last
+    std::vector<std::pair<std::shared_ptr<SwapFile>, std::vector<PageWrite>>> shares;
+    std::unordered_map<uint32_t, size_t> shareOf;
+    for (const auto& page : pages) {
+        auto [it, added] = shareOf.emplace(page.pid, shares.size());
+        if (added)
+            shares.emplace_back(find(page.pid, true), std::vector<PageWrite>{});
+        shares[it->second].second.push_back(page);
+    }
+
+    return runInParallel(shares.size(), [&](size_t share) {
+        return shares[share].first->store->writePages(shares[share].second);
+    });
+}
+
+bool SwapDirectory::contains(uint32_t pid, uint32_t vpn) const {
+    std::shared_ptr<SwapFile> file;
+    {
+        std::lock_guard<std::mutex> lock(filesMutex);
+        auto it = files.find(pid);
+        if (it == files.end()) return false;
+        file = it->second;
+    }
+    return file->store->contains(pid, vpn);
+}
+
+void SwapDirectory::discardPage(uint32_t pid, uint32_t vpn) {
+    std::shared_ptr<SwapFile> file;
+    {
+        std::lock_guard<std::mutex> lock(filesMutex);
+        auto it = files.find(pid);
+        if (it == files.end()) return;
+        file = it->second;
+    }
+    file->store->discardPage(pid, vpn);
+}
+
+// The MemoryManager frees a process only when none of its pages is being read or written,
+// so released holds the last reference and the file is unlinked when it goes out of scope
+void SwapDirectory::releaseProcess(uint32_t pid) {
+    std::shared_ptr<SwapFile> released;
+    {
+        std::lock_guard<std::mutex> lock(filesMutex);
+        auto it = files.find(pid);
+        if (it == files.end()) return;
+        released = std::move(it->second);
+        files.erase(it);
+        openFiles.remove(pid);
+    }
+}
+
+void SwapDirectory::releaseAll() {
+    std::unordered_map<uint32_t, std::shared_ptr<SwapFile>> released;
+    {
+        std::lock_guard<std::mutex> lock(filesMutex);
+        released.swap(files);
+        openFiles.clear();
+    }
+}
+
+size_t SwapDirectory::getUsedSlots() const {
+    size_t used = 0;
+    for (const auto& file : snapshot())
+        used += file->store->getUsedSlots();
+    return used;
+}
+
+size_t SwapDirectory::getFileCount() const {
+    std::lock_guard<std::mutex> lock(filesMutex);
+    return files.size();
+}
+
+void SwapDirectory::flush() {
+    for (const auto& file : snapshot())
+        file->store->flush();
+}
+
+// Returns the process's swap file, creating it if asked, and marks it most recently used.
+// A closed file goes back on the open list here; its store reopens it on the caller's access
+std::shared_ptr<SwapDirectory::SwapFile> SwapDirectory::find(uint32_t pid, bool create) {
+    std::lock_guard<std::mutex> lock(filesMutex);
+
+    auto it = files.find(pid);
+    if (it == files.end()) {
+        if (!create) return nullptr;
+
+        auto file = std::make_shared<SwapFile>();
+        file->path = pathFor(pid);
+        file->store = BackingStore::create(mode, file->path, pageSize);
+        it = files.emplace(pid, std::move(file)).first;
+    }
+
+    auto recent = std::find(openFiles.begin(), openFiles.end(), pid);
+    if (recent != openFiles.end())
+        openFiles.splice(openFiles.begin(), openFiles, recent);
+    else
+        openFiles.push_front(pid);
+
+    closeLeastRecentlyUsed(pid);
+    return it->second;
+}
+
+// Closes the least recently used files until at most MAX_OPEN_FILES are open, skipping the
+// one just handed out and any another thread still holds: closing those would only have
+// their next access reopen them without going through the list (caller holds filesMutex).
+// New references are only taken under filesMutex, so a file used by no one else stays unused
+void SwapDirectory::closeLeastRecentlyUsed(uint32_t keep) {
+    auto victim = openFiles.end();
+    while (openFiles.size() > MAX_OPEN_FILES && victim != openFiles.begin()) {
+        --victim;
+        const auto& file = files.at(*victim);
+        if (*victim == keep || file.use_count() > 1) continue;
+
+        file->store->close();
+        victim = openFiles.erase(victim);
+    }
+}
+
+std::vector<std::shared_ptr<SwapDirectory::SwapFile>> SwapDirectory::snapshot() const {
+    std::lock_guard<std::mutex> lock(filesMutex);
+    std::vector<std::shared_ptr<SwapFile>> result;
+    result.reserve(files.size());
+    for (const auto& [pid, file] : files)
+        result.push_back(file);
+    return result;
+}
+
+std::string SwapDirectory::pathFor(uint32_t pid) const {
+    return (std::filesystem::path(directory) / ("process-" + std::to_string(pid) + ".swap")).string();
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "BackingStore.h"
+
+/**
+ * @class SwapDirectory
+ * @brief Swap space made of one backing store file per process, kept in one directory.
+ *
+ * A process gets its own swap file on its first page-out, with its own slot index and its
+ * own lock, so page-ins and page-outs of different processes never wait on each other's I/O.
+ * A batched read or write that spans several processes uses their files on separate threads:
+ * the calling one and a pool of I/O workers started with the directory, so a batch never
+ * pays for creating threads.
+ * Releasing a finished process closes its file and unlinks it in one step, instead of
+ * handing its slots back one by one to a free list shared with every other process.
+ *
+ * At most MAX_OPEN_FILES files are kept open. The least recently used one is closed (its
+ * pages stay on disk) and is reopened on its next access. A file another thread is using
+ * is not closed until it is idle, so the cap can be exceeded briefly by files in use.
+ */
+class SwapDirectory {
+public:
+    /**
+     * @brief Creates the directory if needed and removes swap files left by a previous run.
+     * @param mode      "file" or "mmap" (see BackingStore::create).
+     * @param directory Directory that holds the swap files.
+     * @param pageSize  Size of one page/slot in bytes.
+     */
+    SwapDirectory(const std::string& mode, const std::string& directory, uint32_t pageSize);
+
+    // Stops the I/O workers and deletes every swap file
+    ~SwapDirectory();
+
+    /**
+     * @brief Reads many pages at once, setting found on each page that was stored. Pages of
+     *        different processes are read in parallel, each file as one BackingStore::readPages batch.
+     * @return Number of I/Os issued.
+     */
+    size_t readPages(std::vector<PageRead>& pages);
+
+    /**
+     * @brief Stores many pages at once, creating swap files as needed. Pages of different
+     *        processes are written in parallel, each file as one BackingStore::writePages batch.
+     * @return Number of I/Os issued.
+     */
+    size_t writePages(const std::vector<PageWrite>& pages);
+
+    bool contains(uint32_t pid, uint32_t vpn) const;
+    void discardPage(uint32_t pid, uint32_t vpn);
+
+    /**
+     * @brief Deletes the process's swap file, if it has one.
+     */
+    void releaseProcess(uint32_t pid);
+
+    /**
+     * @brief Deletes every swap file, e.g. before a checkpoint's pages are written back in.
+     */
+    void releaseAll();
+
+    size_t getUsedSlots() const;
+    size_t getFileCount() const;
+    void flush();
+
+private:
+    static constexpr size_t MAX_OPEN_FILES = 64;
+    static constexpr size_t MAX_IO_THREADS = 4;
+
+    // One process's swap file, closed and unlinked once the last user lets go of it
+    struct SwapFile {
+        std::string path;
+        std::unique_ptr<BackingStore> store;
+        ~SwapFile();
+    };
+
+    size_t runInParallel(size_t count, const std::function<size_t(size_t)>& work);
+    void workerLoop();
+
+    std::shared_ptr<SwapFile> find(uint32_t pid, bool create);
+    void closeLeastRecentlyUsed(uint32_t keep);
+    std::vector<std::shared_ptr<SwapFile>> snapshot() const;
+    std::string pathFor(uint32_t pid) const;
+
+    std::string mode;
+    std::string directory;
+    uint32_t pageSize;
+
+    std::unordered_map<uint32_t, std::shared_ptr<SwapFile>> files;
+    std::list<uint32_t> openFiles;                  // Exactly the pids of the open files, most recently used first
+
+    // Guards files and openFiles only; each file's I/O is guarded by its own store's lock
+    mutable std::mutex filesMutex;
+
+    std::vector<std::thread> workers;               // MAX_IO_THREADS - 1, the caller being the last one
+    std::deque<std::function<void()>> tasks;        // Shares of batches waiting for a worker
+    bool stopping = false;
+
+    // Guards tasks, stopping and the progress of every batch in runInParallel
+    std::mutex workMutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+};
@@ -0,0 +1,107 @@
+#include "SwapIoQueue.h"
+
+#include <algorithm>
+#include <exception>
+
+void SwapIoQueue::submit(std::vector<SwapIoRequest>& requests) {
+    if (requests.empty()) return;
+
+    size_t remaining = requests.size();
+    std::exception_ptr failure;
+    std::unique_lock<std::mutex> lock(queueMutex);
+    const auto submittedAt = Clock::now();
+    for (auto& request : requests)
+        pending.push_back({ &request, submittedAt, &remaining, &failure });
+
+    while (remaining > 0) {
+        if (dispatching) {
+            roundDone.wait(lock);
+            continue;
+        }
+
+        // The queue is idle: this thread dispatches everything pending, other threads' requests included
+        std::vector<Pending> round;
+        round.swap(pending);
+        dispatching = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        Round times;
+        try {
+            times = serve(round);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        // A failed round fails every submit call that had a request in it, not only this one
+        lock.lock();
+        if (!error) record(round, times);
+        for (const auto& entry : round) {
+            if (error) *entry.failure = error;
+            --*entry.remaining;
+        }
+        dispatching = false;
+        roundDone.notify_all();
+    }
+
+    if (failure) std::rethrow_exception(failure);
+}
+
+SwapIoStats SwapIoQueue::getReadStats() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return readStats;
+}
+
+SwapIoStats SwapIoQueue::getWriteStats() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return writeStats;
+}
+
+// Writes, then reads, everything in the round (called without queueMutex)
+SwapIoQueue::Round SwapIoQueue::serve(std::vector<Pending>& round) {
+    Round times;
+    times.dispatchedAt = Clock::now();
+
+    std::vector<PageWrite> writes;
+    for (const auto& entry : round) {
+        if (entry.request->write)
+            writes.push_back({ entry.request->pid, entry.request->vpn, entry.request->data });
+    }
+    times.writeOperations = store.writePages(writes);
+    times.writesDone = Clock::now();
+
+    std::vector<PageRead> reads;
+    std::vector<SwapIoRequest*> readRequests;
+    for (const auto& entry : round) {
+        if (entry.request->write) continue;
+        reads.push_back({ entry.request->pid, entry.request->vpn, entry.request->data });
+        readRequests.push_back(entry.request);
+    }
+    times.readOperations = store.readPages(reads);
+    for (size_t i = 0; i < reads.size(); ++i)
+        readRequests[i]->found = reads[i].found;
+    times.readsDone = Clock::now();
+
+    return times;
+}
+
+// Adds the round's requests to the statistics (caller holds queueMutex)
+void SwapIoQueue::record(const std::vector<Pending>& round, const Round& times) {
+    auto micros = [](Clock::duration duration) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+
+    for (const auto& entry : round) {
+        SwapIoStats& stats = entry.request->write ? writeStats : readStats;
+        uint64_t queueUs = micros(times.dispatchedAt - entry.submittedAt);
+        uint64_t serviceUs = micros((entry.request->write ? times.writesDone : times.readsDone) - times.dispatchedAt);
+
+        ++stats.requests;
+        stats.totalQueueUs += queueUs;
+        stats.maxQueueUs = std::max(stats.maxQueueUs, queueUs);
+        stats.totalServiceUs += serviceUs;
+        stats.maxServiceUs = std::max(stats.maxServiceUs, serviceUs);
+    }
+    writeStats.operations += times.writeOperations;
+    readStats.operations += times.readOperations;
+}
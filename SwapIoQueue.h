@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "SwapDirectory.h"
+
+/**
+ * @struct SwapIoRequest
+ * @brief One page to read from or write to swap through the SwapIoQueue.
+ */
+struct SwapIoRequest {
+    uint32_t pid;
+    uint32_t vpn;
+    uint8_t* data;          // Read: where the page goes. Write: the page to store
+    bool write;
+    bool found = false;     // Read: the page was stored and data now holds it
+};
+
+/**
+ * @struct SwapIoStats
+ * @brief Requests and timings of one direction (reads or writes) of the SwapIoQueue.
+ */
+struct SwapIoStats {
+    uint64_t requests = 0;
+    uint64_t operations = 0;        // I/Os issued once adjacent slots were merged
+    uint64_t totalQueueUs = 0;      // Submitted until dispatched
+    uint64_t maxQueueUs = 0;
+    uint64_t totalServiceUs = 0;    // Dispatched until done
+    uint64_t maxServiceUs = 0;
+
+    double averageQueueMs() const { return requests ? totalQueueUs / 1000.0 / requests : 0.0; }
+    double averageServiceMs() const { return requests ? totalServiceUs / 1000.0 / requests : 0.0; }
+};
+
+/**
+ * @class SwapIoQueue
+ * @brief Elevator-style queue that every swap read and write of the MemoryManager goes through.
+ *
+ * Requests submitted while a round of I/O is in progress wait in the queue and are dispatched
+ * together in the next round, whoever submitted them (page faults, the write-back daemon,
+ * compressed pool spills). The thread that finds the queue idle dispatches the round itself,
+ * so there is no I/O thread. A round writes first, then reads; each swap file serves its share
+ * in C-LOOK order with adjacent slots merged into one I/O (see BackingStore::readPages).
+ *
+ * Every request's queue latency (submitted until its round is dispatched) and service time
+ * (dispatched until its part of the round is done) is recorded, separately for reads and writes.
+ */
+class SwapIoQueue {
+public:
+    explicit SwapIoQueue(SwapDirectory& store) : store(store) {}
+
+    // Queues the requests and returns once every one of them has been served. Throws the
+    // error of a round that failed to serve any of them, whichever thread dispatched it
+    void submit(std::vector<SwapIoRequest>& requests);
+
+    SwapIoStats getReadStats() const;
+    SwapIoStats getWriteStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        SwapIoRequest* request;
+        Clock::time_point submittedAt;
+        size_t* remaining;              // Requests of the same submit call not served yet
+        std::exception_ptr* failure;    // Error of a round that served one of them, if any
+    };
+
+    struct Round {
+        Clock::time_point dispatchedAt;
+        Clock::time_point writesDone;
+        Clock::time_point readsDone;
+        size_t writeOperations = 0;
+        size_t readOperations = 0;
+    };
+
+    Round serve(std::vector<Pending>& round);
+    void record(const std::vector<Pending>& round, const Round& times);
+
+    SwapDirectory& store;
+
+    std::vector<Pending> pending;
+    bool dispatching = false;
+    SwapIoStats readStats;
+    SwapIoStats writeStats;
+
+    mutable std::mutex queueMutex;
+    std::condition_variable roundDone;
+};
@@ -53,17 +53,17 @@ void SystemConfig::validate() const {
 
     // MO2 Parameters
 
-    auto isValidMemory = [](uint32_t val) {
-        return (val > 0 && val <= 65536) && ((val & (val - 1)) == 0);
+    auto isValidMemory = [](unsigned long val) {
+        return (val >= MIN_MEMORY_SIZE && val <= MAX_MEMORY_SIZE) && ((val & (val - 1)) == 0);
     };
 
     if (!isValidMemory(maxOverallMemory)) {
-        CU::printColoredText(Color::Yellow, "[!] max-overall-mem must be a power of 2 in the range [64 ?, 65536]. Using default value of 4096.\n");
+        CU::printColoredText(Color::Yellow, "[!] max-overall-mem must be a power of 2 in the range [" + std::to_string(MIN_MEMORY_SIZE) + ", " + std::to_string(MAX_MEMORY_SIZE) + "]. Using default value of 4096.\n");
         const_cast<SystemConfig*>(this)->maxOverallMemory = 4096;
     }
 
     if (!isValidMemory(memoryPerFrame)) {
-        CU::printColoredText(Color::Yellow, "[!] mem-per-frame must be a power of 2 in the range [64 ?, 65536]. Using default value of 256.\n");
+        CU::printColoredText(Color::Yellow, "[!] mem-per-frame must be a power of 2 in the range [" + std::to_string(MIN_MEMORY_SIZE) + ", " + std::to_string(MAX_MEMORY_SIZE) + "]. Using default value of 256.\n");
         const_cast<SystemConfig*>(this)->memoryPerFrame = 256;
     }
 
@@ -73,12 +73,12 @@ void SystemConfig::validate() const {
     }
 
     if (!isValidMemory(minMemoryPerProcess)) {
-        CU::printColoredText(Color::Yellow, "[!] min-mem-per-proc must be a power of 2 in the range [64 ?, 65536]. Using default value of 64.\n");
+        CU::printColoredText(Color::Yellow, "[!] min-mem-per-proc must be a power of 2 in the range [" + std::to_string(MIN_MEMORY_SIZE) + ", " + std::to_string(MAX_MEMORY_SIZE) + "]. Using default value of 64.\n");
         const_cast<SystemConfig*>(this)->minMemoryPerProcess = 64;
     }
 
     if (!isValidMemory(maxMemoryPerProcess)) {
-        CU::printColoredText(Color::Yellow, "[!] max-mem-per-proc must be a power of 2 in the range [64 ?, 65536]. Using default value of 1024.\n");
+        CU::printColoredText(Color::Yellow, "[!] max-mem-per-proc must be a power of 2 in the range [" + std::to_string(MIN_MEMORY_SIZE) + ", " + std::to_string(MAX_MEMORY_SIZE) + "]. Using default value of 1024.\n");
         const_cast<SystemConfig*>(this)->maxMemoryPerProcess = 1024;
     }
 
@@ -87,6 +87,32 @@ void SystemConfig::validate() const {
         const_cast<SystemConfig*>(this)->minMemoryPerProcess = 512;
         const_cast<SystemConfig*>(this)->maxMemoryPerProcess = 1024;
     }
+
+    if (backingStore != "file" && backingStore != "mmap") {
+        CU::printColoredText(Color::Yellow, "[!] invalid backing-store. Must be 'file' or 'mmap' (memory-mapped). Using default value of 'file'.\n");
+        const_cast<SystemConfig*>(this)->backingStore = "file";
+    }
+
+    if (pageReplacement != "fifo" && pageReplacement != "clock" && pageReplacement != "second-chance" &&
+        pageReplacement != "lru" && pageReplacement != "lfu") {
+        CU::printColoredText(Color::Yellow, "[!] invalid page-replacement. Must be 'fifo', 'clock', 'second-chance', 'lru' or 'lfu'. Using default value of 'fifo'.\n");
+        const_cast<SystemConfig*>(this)->pageReplacement = "fifo";
+    }
+
+    if (compressedPoolSize > maxOverallMemory) {
+        CU::printColoredText(Color::Yellow, "[!] compressed-pool-size cannot be greater than max-overall-mem. Using max-overall-mem / 4.\n");
+        const_cast<SystemConfig*>(this)->compressedPoolSize = maxOverallMemory / 4;
+    }
+
+    if (hugeFrames != "on" && hugeFrames != "off") {
+        CU::printColoredText(Color::Yellow, "[!] invalid huge-frames. Must be 'on' or 'off'. Using default value of 'off'.\n");
+        const_cast<SystemConfig*>(this)->hugeFrames = "off";
+    }
+
+    if (compactThreshold > 100) {
+        CU::printColoredText(Color::Yellow, "[!] compact-threshold must be in the range [0, 100]. Using default value of 0.\n");
+        const_cast<SystemConfig*>(this)->compactThreshold = 0;
+    }
 }
 SystemConfig SystemConfig::loadFromFile(const std::string& filename) {
     SystemConfig config;
@@ -130,10 +156,30 @@ SystemConfig SystemConfig::loadFromFile(const std::string& filename) {
             else if (key == "min-ins") config.minInstructions = std::stol(value);
             else if (key == "max-ins") config.maxInstructions = std::stol(value);
             else if (key == "delays-per-exec") config.delaysPerExec = std::stol(value);
-            else if (key == "max-overall-mem") config.maxOverallMemory = std::stol(value);
-            else if (key == "mem-per-frame") config.memoryPerFrame = std::stol(value);
-			else if (key == "min-mem-per-proc") config.minMemoryPerProcess = std::stol(value);
-            else if (key == "max-mem-per-proc") config.maxMemoryPerProcess = std::stol(value);
+            else if (key == "max-overall-mem") config.maxOverallMemory = std::stoul(value);
+            else if (key == "mem-per-frame") config.memoryPerFrame = std::stoul(value);
+			else if (key == "min-mem-per-proc") config.minMemoryPerProcess = std::stoul(value);
+            else if (key == "max-mem-per-proc") config.maxMemoryPerProcess = std::stoul(value);
+            else if (key == "backing-store") {
+                if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                    value = value.substr(1, value.size() - 2);
+                }
+                config.backingStore = value;
+            }
+            else if (key == "page-replacement") {
+                if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                    value = value.substr(1, value.size() - 2);
+                }
+                config.pageReplacement = value;
+            }
+            else if (key == "compressed-pool-size") config.compressedPoolSize = std::stoul(value);
+            else if (key == "huge-frames") {
+                if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                    value = value.substr(1, value.size() - 2);
+                }
+                config.hugeFrames = value;
+            }
+            else if (key == "compact-threshold") config.compactThreshold = std::stoul(value);
             else { CU::printColoredText(CU::Color::Red, "[X] Unknown config key: \"" + key + "\"\n"); }
         }
         catch (...) {
@@ -165,6 +211,11 @@ void SystemConfig::printSystemConfig() const {
 	std::cout << "Memory per Frame    : " << memoryPerFrame << "\n";
     std::cout << "Min Memory per Process  : " << minMemoryPerProcess << "\n";
     std::cout << "Max Memory per Process  : " << maxMemoryPerProcess << "\n";
+    std::cout << "Backing Store       : " << backingStore << "\n";
+    std::cout << "Page Replacement    : " << pageReplacement << "\n";
+    std::cout << "Compressed Pool Size: " << compressedPoolSize << "\n";
+    std::cout << "Huge Frames         : " << hugeFrames << "\n";
+    std::cout << "Compact Threshold   : " << compactThreshold << "\n";
 }
 
 bool SystemConfig::fileExists(const std::string& path) {
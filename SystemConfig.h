@@ -34,6 +34,20 @@
  *      Minimum memory allocated per process (in bytes).
  * @var unsigned long maxMemoryPerProcess
  *      Maximum memory allocated per process (in bytes).
+ * @var std::string backingStore
+ *      Backing store implementation ("file" for a binary swap file, "mmap" for a memory-mapped one).
+ * @var std::string pageReplacement
+ *      Page replacement policy ("fifo", "clock", "second-chance", "lru" or "lfu").
+ * @var unsigned long compressedPoolSize
+ *      Bytes of RAM for compressed evicted pages in front of the backing store (0 disables it).
+ * @var std::string hugeFrames
+ *      "on" to map large processes with huge frames of 16 frames each, "off" for base frames only.
+ * @var unsigned long compactThreshold
+ *      Fragmentation (percent of possible huge frames that are broken up) above which memory is compacted; 0 disables it.
+ * @var unsigned long MIN_MEMORY_SIZE
+ *      Lower bound of every memory size setting (2 bytes, enough for one uint16 variable).
+ * @var unsigned long MAX_MEMORY_SIZE
+ *      Upper bound of every memory size setting (1 GiB).
  *
  * @fn void validate() const
  *      Validates the current configuration parameters.
@@ -62,6 +76,15 @@ public:
 	unsigned long memoryPerFrame = 256;
 	unsigned long minMemoryPerProcess = 512;
     unsigned long maxMemoryPerProcess = 1024;
+    std::string backingStore = "file";
+    std::string pageReplacement = "fifo";
+    unsigned long compressedPoolSize = 1024;
+    std::string hugeFrames = "off";
+    unsigned long compactThreshold = 0;
+
+    // Smallest and largest accepted values for the memory sizes above (2 bytes to 1 GiB)
+    static constexpr unsigned long MIN_MEMORY_SIZE = 2;
+    static constexpr unsigned long MAX_MEMORY_SIZE = 1ul << 30;
 
     void validate() const;
     static SystemConfig loadFromFile(const std::string& filename);
@@ -0,0 +1,34 @@
+#include "TLB.h"
+
+// Direct-mapped slot index mixing the pid so processes with the same vpn don't always collide
+size_t TLB::slotFor(uint32_t pid, uint32_t vpn) {
+    return (vpn + pid * 7) % TLB_ENTRIES;
+}
+
+TLB::Entry* TLB::lookup(uint32_t pid, uint32_t vpn) {
+    Entry& entry = entries[slotFor(pid, vpn)];
+    if (entry.valid && entry.pid == pid && entry.vpn == vpn)
+        return &entry;
+    return nullptr;
+}
+
+void TLB::insert(uint32_t pid, uint32_t vpn, uint32_t frameNumber, PageTableEntry* pte) {
+    entries[slotFor(pid, vpn)] = { true, pid, vpn, frameNumber, pte };
+}
+
+void TLB::invalidate(uint32_t pid, uint32_t vpn) {
+    Entry& entry = entries[slotFor(pid, vpn)];
+    if (entry.valid && entry.pid == pid && entry.vpn == vpn)
+        entry.valid = false;
+}
+
+void TLB::invalidateProcess(uint32_t pid) {
+    for (auto& entry : entries) {
+        if (entry.pid == pid) entry.valid = false;
+    }
+}
+
+void TLB::flush() {
+    for (auto& entry : entries)
+        entry.valid = false;
+}
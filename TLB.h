@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+struct PageTableEntry;
+
+/**
+ * @class TLB
+ * @brief Small software translation lookaside buffer owned by a Core.
+ *
+ * Caches (pid, vpn) -> (frame, page table entry) translations so that READ and WRITE
+ * instructions hitting a resident page skip the page-table walk. The buffer is
+ * direct-mapped: each (pid, vpn) can only live in one slot, so lookups, inserts and
+ * invalidations are O(1). The MemoryManager invalidates entries whenever a page
+ * is evicted or a process's pages are freed.
+ */
+class TLB {
+public:
+    static constexpr size_t TLB_ENTRIES = 16;
+
+    /**
+     * @struct Entry
+     * @brief One cached translation.
+     */
+    struct Entry {
+        bool valid = false;
+        uint32_t pid = 0;
+        uint32_t vpn = 0;
+        uint32_t frameNumber = 0;
+        PageTableEntry* pte = nullptr;  // Lets hits update dirty/referenced bits without a page-table lookup
+    };
+
+    /**
+     * @brief Returns the cached translation for (pid, vpn), if any.
+     */
+    Entry* lookup(uint32_t pid, uint32_t vpn);
+
+    /**
+     * @brief Caches a translation, replacing whatever occupied its slot.
+     */
+    void insert(uint32_t pid, uint32_t vpn, uint32_t frameNumber, PageTableEntry* pte);
+
+    /**
+     * @brief Drops the translation for (pid, vpn) if it is cached.
+     */
+    void invalidate(uint32_t pid, uint32_t vpn);
+
+    /**
+     * @brief Drops every translation belonging to a process.
+     */
+    void invalidateProcess(uint32_t pid);
+
+    /**
+     * @brief Drops every translation.
+     */
+    void flush();
+
+private:
+    static size_t slotFor(uint32_t pid, uint32_t vpn);
+
+    std::array<Entry, TLB_ENTRIES> entries;
+};
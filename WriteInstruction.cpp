@@ -7,8 +7,8 @@
 #include <iomanip>
 #include <algorithm>
 
-// Constructor: initializes address and value (can be string or uint16_t)
-WriteInstruction::WriteInstruction(std::variant<std::string, uint16_t> addr, std::variant<std::string, uint16_t> val)
+// Constructor: initializes address (string or uint32_t) and value (string or uint16_t)
+WriteInstruction::WriteInstruction(std::variant<std::string, uint32_t> addr, std::variant<std::string, uint16_t> val)
     : address(addr), value(val) {}
 
 // Executes the write instruction for the given process
@@ -16,17 +16,17 @@ int WriteInstruction::execute(Process& process) {
     uint32_t virtualAddress = 0;
     uint16_t valueToWrite = 0;
 
-    // Resolve address: if string, get variable value; else use uint16_t directly
+    // Resolve address: if string, get variable value; else use uint32_t directly
     if (std::holds_alternative<std::string>(address))
         virtualAddress = process.getVariable(std::get<std::string>(address));
     else
-        virtualAddress = std::get<uint16_t>(address);
+        virtualAddress = std::get<uint32_t>(address);
 
     // Check for memory violation (address out of bounds)
-    if (virtualAddress + 1 >= process.getMemoryRequired()) {
+    if (static_cast<uint64_t>(virtualAddress) + 1 >= process.getMemoryRequired()) {
+        // The scheduler frees its memory and unregisters it
         process.markTerminatedByMemoryViolation(virtualAddress);
         process.setState(ProcessState::Terminated);
-        Process::unregisterProcess(process.getPID());
         return -1;
     }
 
@@ -36,15 +36,10 @@ int WriteInstruction::execute(Process& process) {
     else
         valueToWrite = std::get<uint16_t>(value);
 
-    // Try to access memory (get physical address)
-    auto physicalAddrOpt = MemoryManager::getInstance()->accessMemory(process.shared_from_this(), virtualAddress, true);
-    if (!physicalAddrOpt.has_value()) {
-        process.setState(ProcessState::Blocked); // Block if memory not available
+    // Translate the address and write the value in one step. On failure the MemoryManager
+    // has already blocked or terminated the process (see ReadInstruction::execute)
+    if (!MemoryManager::getInstance()->writeVirtual(process, virtualAddress, valueToWrite))
         return -1;
-    }
-
-    // Write the value to the resolved physical address
-    MemoryManager::getInstance()->writeUint16At(physicalAddrOpt.value(), valueToWrite);
 
     // Log the write operation
     std::stringstream ss;
@@ -64,4 +59,8 @@ std::string WriteInstruction::toString() const {
     else
         oss << std::get<uint16_t>(value);
     return oss.str();
+}
+
+std::string WriteInstruction::toSource() const {
+    return "WRITE " + operandToSource(address) + " " + operandToSource(value);
 }
\ No newline at end of file
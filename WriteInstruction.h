@@ -8,11 +8,11 @@
  * @class WriteInstruction
  * @brief Represents an instruction to write a value to a specified address in a process.
  *
- * This instruction can target either a named variable (std::string) or a direct memory address (uint16_t),
+ * This instruction can target either a named variable (std::string) or a direct memory address (uint32_t),
  * and can write a value from either a named source or a direct value.
  *
  * @constructor
- * @param targetAddr The address or variable name to write to (std::variant<std::string, uint16_t>).
+ * @param targetAddr The address or variable name to write to (std::variant<std::string, uint32_t>).
  * @param valueSrc The value or variable name to write from (std::variant<std::string, uint16_t>).
  *
  * @function execute
@@ -30,11 +30,12 @@
  */
 class WriteInstruction : public Instruction {
 public:
-    WriteInstruction(std::variant<std::string, uint16_t> targetAddr, std::variant<std::string, uint16_t> valueSrc);
+    WriteInstruction(std::variant<std::string, uint32_t> targetAddr, std::variant<std::string, uint16_t> valueSrc);
     int execute(Process& process) override;
     std::string toString() const override;
+    std::string toSource() const override;
 
 private:
-    std::variant<std::string, uint16_t> address;
+    std::variant<std::string, uint32_t> address;
     std::variant<std::string, uint16_t> value;
 };
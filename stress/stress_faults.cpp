@@ -0,0 +1,285 @@
+// Multi-core page fault stress test for the MemoryManager.
+//
+// Runs the same workload with 1, 2, 4, ... threads, each thread acting as one core: it owns
+// a share of the processes and does random 16-bit reads and writes to them through its own
+// TLB. The processes' pages add up to four times physical memory and the compressed pool is
+// off, so most accesses fault a page in from swap and evict another one. Every value read is
+// checked against a shadow copy of what was written.
+//
+// Then, in memory of only a few frames, one core keeps opening shared-memory segments of half
+// of memory (which evict every other page to make room) while the others fault sequentially
+// with read-ahead, so at times the only frames left to evict are being read in from swap. The
+// opens have to keep completing.
+//
+// Prints fault throughput per thread count and exits with 1 if any value read back was wrong
+// or the segment opens stop making progress.
+//
+// Build from the repository root, like main but with this file in place of main.cpp:
+//   g++ -std=c++20 -O2 -I. stress/stress_faults.cpp <every .cpp but main.cpp> -o stress_faults -pthread
+// Usage: stress_faults [max-threads] [page-replacement] [backing-store]
+
+#include "GlobalScheduler.h"
+#include "MemoryManager.h"
+#include "Process.h"
+#include "SystemConfig.h"
+#include "TLB.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t FRAME_SIZE = 64;
+static constexpr uint32_t TOTAL_FRAMES = 256;
+static constexpr uint32_t TOTAL_PAGES = TOTAL_FRAMES * 4;       // Pages of every process together
+static constexpr uint32_t PROCESSES_PER_THREAD = 4;
+static constexpr uint32_t TOTAL_ACCESSES = 200000;              // Split evenly between the threads
+
+static constexpr uint32_t SHM_CASE_FRAMES = 8;
+static constexpr uint32_t SHM_CASE_PAGES = 8;                    // Pages of each faulting process
+static constexpr auto SHM_CASE_DURATION = std::chrono::seconds(5);
+static constexpr auto SHM_CASE_TIME_LIMIT = std::chrono::seconds(30);   // For the last open to return once stopped
+
+/**
+ * @struct RoundResult
+ * @brief Counters of one run of the workload with a given number of threads.
+ */
+struct RoundResult {
+    double seconds = 0.0;
+    uint64_t blocked = 0;       // Accesses that blocked on memory instead of completing
+    uint64_t faults = 0;
+    uint64_t mismatches = 0;
+};
+
+// One thread's share of the workload: random accesses to its own processes, checked against
+// the values it wrote
+static void runCore(int coreId, const std::vector<std::shared_ptr<Process>>& processes, uint32_t accesses,
+                    std::atomic<uint64_t>& blocked, std::atomic<uint64_t>& mismatches) {
+    auto memoryManager = MemoryManager::getInstance();
+    TLB tlb;
+    memoryManager->registerTLB(coreId, &tlb);
+
+    std::vector<std::vector<uint16_t>> shadow;
+    for (const auto& process : processes)
+        shadow.emplace_back(process->getMemoryRequired() / 2, 0);
+
+    std::mt19937 rng(coreId + 1);
+    for (uint32_t i = 0; i < accesses; ++i) {
+        size_t index = rng() % processes.size();
+        Process& process = *processes[index];
+        uint32_t word = rng() % shadow[index].size();
+
+        // A blocked process is retried by its next access, as the scheduler would
+        process.setState(ProcessState::Running);
+        if (rng() % 2) {
+            uint16_t value = static_cast<uint16_t>(rng());
+            if (!memoryManager->writeVirtual(process, word * 2, value)) {
+                ++blocked;
+                continue;
+            }
+            shadow[index][word] = value;
+        } else {
+            std::optional<uint16_t> value = memoryManager->readVirtual(process, word * 2);
+            if (!value) {
+                ++blocked;
+                continue;
+            }
+            if (*value != shadow[index][word]) ++mismatches;
+        }
+    }
+
+    memoryManager->unregisterTLB(coreId);
+}
+
+// Runs the whole workload split between threads and frees its processes afterwards
+static RoundResult runRound(int threads) {
+    auto memoryManager = MemoryManager::getInstance();
+    const uint32_t processCount = threads * PROCESSES_PER_THREAD;
+    const uint32_t pagesPerProcess = TOTAL_PAGES / processCount;
+
+    std::vector<std::vector<std::shared_ptr<Process>>> owned(threads);
+    for (uint32_t i = 0; i < processCount; ++i) {
+        auto process = std::make_shared<Process>("stress" + std::to_string(i), std::vector<std::shared_ptr<Instruction>>{},
+                                                 pagesPerProcess * FRAME_SIZE, pagesPerProcess);
+        process->setCoreID(i % threads);
+        Process::registerProcess(process);
+        memoryManager->allocatePageTable(process);
+        owned[i % threads].push_back(process);
+    }
+
+    std::atomic<uint64_t> blocked = 0;
+    std::atomic<uint64_t> mismatches = 0;
+    const uint64_t faultsBefore = memoryManager->getPageFaults();
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> cores;
+    for (int coreId = 0; coreId < threads; ++coreId)
+        cores.emplace_back(runCore, coreId, std::cref(owned[coreId]), TOTAL_ACCESSES / threads,
+                           std::ref(blocked), std::ref(mismatches));
+    for (auto& core : cores)
+        core.join();
+
+    RoundResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.blocked = blocked;
+    result.faults = memoryManager->getPageFaults() - faultsBefore;
+    result.mismatches = mismatches;
+
+    for (const auto& processes : owned) {
+        for (const auto& process : processes) {
+            memoryManager->freeProcessPages(process->getPID());
+            Process::unregisterProcess(process->getPID());
+        }
+    }
+    return result;
+}
+
+// One core of the shared-memory case: sweeps its process's pages in order, so every fault is
+// sequential and reads ahead, until stop is set
+static void sweepPages(int coreId, Process& process, const std::atomic<bool>& stop) {
+    auto memoryManager = MemoryManager::getInstance();
+    TLB tlb;
+    memoryManager->registerTLB(coreId, &tlb);
+
+    for (uint32_t vpn = 0; !stop; vpn = (vpn + 1) % SHM_CASE_PAGES) {
+        process.setState(ProcessState::Running);
+        memoryManager->writeVirtual(process, vpn * FRAME_SIZE, static_cast<uint16_t>(vpn));
+    }
+
+    memoryManager->unregisterTLB(coreId);
+}
+
+// Opens segments of half of memory, the most that may be pinned, one after another from a
+// process of its own while the other threads sweep their pages, freeing each segment again.
+// Runs for SHM_CASE_DURATION. Returns false if the open under way then does not return within
+// SHM_CASE_TIME_LIMIT; it is stuck behind memoryMutex for good, and so are the sweepers
+static bool runSharedMemoryCase(int threads, uint64_t& opened, uint64_t& deniedForMemory) {
+    auto memoryManager = MemoryManager::getInstance();
+
+    std::vector<std::shared_ptr<Process>> sweepers;
+    for (int i = 1; i < threads; ++i) {
+        auto process = std::make_shared<Process>("sweep" + std::to_string(i), std::vector<std::shared_ptr<Instruction>>{},
+                                                 SHM_CASE_PAGES * FRAME_SIZE, SHM_CASE_PAGES);
+        process->setCoreID(i);
+        Process::registerProcess(process);
+        memoryManager->allocatePageTable(process);
+        sweepers.push_back(process);
+    }
+
+    std::atomic<bool> stop = false;
+    std::atomic<bool> done = false;
+    std::vector<std::thread> cores;
+    for (int i = 1; i < threads; ++i)
+        cores.emplace_back(sweepPages, i, std::ref(*sweepers[i - 1]), std::cref(stop));
+
+    std::thread opener([&] {
+        for (uint32_t i = 0; !stop; ++i) {
+            auto process = std::make_shared<Process>("opener" + std::to_string(i), std::vector<std::shared_ptr<Instruction>>{},
+                                                     FRAME_SIZE, 1);
+            Process::registerProcess(process);
+            memoryManager->allocatePageTable(process);
+
+            process->setState(ProcessState::Running);
+            SharedMemoryStatus status = memoryManager->openSharedSegment(*process, "stress" + std::to_string(i),
+                                                                          SHM_CASE_FRAMES / 2 * FRAME_SIZE);
+            if (status == SharedMemoryStatus::Ok) ++opened;
+            else if (status == SharedMemoryStatus::NoMemory) ++deniedForMemory;
+
+            memoryManager->freeProcessPages(process->getPID());
+            Process::unregisterProcess(process->getPID());
+
+            // Let the sweepers get back into their reads before the next open
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    std::this_thread::sleep_for(SHM_CASE_DURATION);
+    stop = true;
+
+    const auto deadline = std::chrono::steady_clock::now() + SHM_CASE_TIME_LIMIT;
+    while (!done && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (!done) {
+        // The stuck threads can never be joined
+        opener.detach();
+        for (auto& core : cores)
+            core.detach();
+        return false;
+    }
+
+    opener.join();
+    for (auto& core : cores)
+        core.join();
+    for (const auto& process : sweepers) {
+        memoryManager->freeProcessPages(process->getPID());
+        Process::unregisterProcess(process->getPID());
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const int maxThreads = argc > 1 ? std::max(1, std::atoi(argv[1])) : 8;
+
+    SystemConfig config;
+    config.numCPU = maxThreads;
+    config.maxOverallMemory = TOTAL_FRAMES * FRAME_SIZE;
+    config.memoryPerFrame = FRAME_SIZE;
+    config.compressedPoolSize = 0;
+    if (argc > 2) config.pageReplacement = argv[2];
+    if (argc > 3) config.backingStore = argv[3];
+
+    MemoryManager::initialize(config);
+    GlobalScheduler::initialize(config);
+
+    std::cout << "policy " << config.pageReplacement << ", store " << config.backingStore << ", "
+              << TOTAL_FRAMES << " frames of " << FRAME_SIZE << " bytes, " << TOTAL_PAGES << " pages, "
+              << TOTAL_ACCESSES << " accesses per run\n\n";
+    std::cout << std::left << std::setw(10) << "threads" << std::setw(12) << "seconds" << std::setw(10) << "faults"
+              << std::setw(14) << "faults/s" << std::setw(10) << "speedup" << std::setw(10) << "blocked"
+              << "mismatches\n";
+
+    uint64_t totalMismatches = 0;
+    double baseline = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        RoundResult result = runRound(threads);
+        double faultsPerSecond = result.faults / result.seconds;
+        if (threads == 1) baseline = faultsPerSecond;
+        totalMismatches += result.mismatches;
+
+        std::cout << std::left << std::setw(10) << threads << std::setw(12) << std::fixed << std::setprecision(3)
+                  << result.seconds << std::setw(10) << result.faults << std::setw(14) << std::setprecision(0)
+                  << faultsPerSecond << std::setw(10) << std::setprecision(2) << faultsPerSecond / baseline
+                  << std::setw(10) << result.blocked << result.mismatches << "\n";
+    }
+
+    MemoryManager::destroy();
+
+    // The shared-memory case needs a MemoryManager with only a few frames
+    config.maxOverallMemory = SHM_CASE_FRAMES * FRAME_SIZE;
+    MemoryManager::initialize(config);
+
+    uint64_t opened = 0;
+    uint64_t deniedForMemory = 0;
+    const int shmThreads = std::max(2, maxThreads);
+    std::cout << "\nSHM_OPEN under paging (" << SHM_CASE_FRAMES << " frames, " << shmThreads - 1
+              << " sweeping cores): ";
+    if (!runSharedMemoryCase(shmThreads, opened, deniedForMemory)) {
+        // Leave without running destructors, which would wait on the stuck threads
+        std::cout << "an open has not returned after " << SHM_CASE_TIME_LIMIT.count() << " s, stuck" << std::endl;
+        std::_Exit(1);
+    }
+    std::cout << opened << " opened, " << deniedForMemory << " denied for memory\n";
+
+    MemoryManager::destroy();
+    GlobalScheduler::destroy();
+    return totalMismatches == 0 ? 0 : 1;
+}
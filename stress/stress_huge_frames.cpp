@@ -0,0 +1,141 @@
+// Huge frame benchmark for the MemoryManager.
+//
+// Runs the same single-core workload with huge frames off and on, at a few physical memory
+// sizes: random 16-bit reads and writes to processes whose pages add up to 192 frames, from
+// memory that holds all of them down to memory that is overcommitted. The random sequence is
+// fixed, so every run makes the same accesses and the fault counts are reproducible. Every
+// value read is checked against a shadow copy of what was written.
+//
+// Prints the faults of each run and exits with 1 if any value read back was wrong.
+//
+// Build from the repository root, like main but with this file in place of main.cpp:
+//   g++ -std=c++20 -O2 -I. stress/stress_huge_frames.cpp <every .cpp but main.cpp> -o stress_huge_frames -pthread
+// Usage: stress_huge_frames [page-replacement] [backing-store]
+
+#include "GlobalScheduler.h"
+#include "MemoryManager.h"
+#include "Process.h"
+#include "SystemConfig.h"
+#include "TLB.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+static constexpr uint32_t FRAME_SIZE = 64;
+static constexpr uint32_t PROCESS_COUNT = 6;
+static constexpr uint32_t PAGES_PER_PROCESS = 32;
+static constexpr uint32_t ACCESSES = 20000;
+static constexpr uint32_t FRAME_COUNTS[] = { 256, 192, 128 };
+
+/**
+ * @struct RunResult
+ * @brief Counters of one run of the workload.
+ */
+struct RunResult {
+    double seconds = 0.0;
+    uint64_t faults = 0;
+    uint64_t hugeFaults = 0;
+    uint32_t pagedIn = 0;
+    uint64_t blocked = 0;       // Accesses that blocked on memory instead of completing
+    uint64_t mismatches = 0;
+};
+
+// Runs the workload on a fresh MemoryManager with the given memory size and huge frame setting
+static RunResult runWorkload(SystemConfig config, uint32_t frames, bool hugeFrames) {
+    config.maxOverallMemory = frames * FRAME_SIZE;
+    config.hugeFrames = hugeFrames ? "on" : "off";
+    MemoryManager::initialize(config);
+    auto memoryManager = MemoryManager::getInstance();
+
+    TLB tlb;
+    memoryManager->registerTLB(0, &tlb);
+
+    std::vector<std::shared_ptr<Process>> processes;
+    for (uint32_t i = 0; i < PROCESS_COUNT; ++i) {
+        auto process = std::make_shared<Process>("bench" + std::to_string(i), std::vector<std::shared_ptr<Instruction>>{},
+                                                 PAGES_PER_PROCESS * FRAME_SIZE, PAGES_PER_PROCESS);
+        process->setCoreID(0);
+        Process::registerProcess(process);
+        memoryManager->allocatePageTable(process);
+        processes.push_back(process);
+    }
+    std::vector<std::vector<uint16_t>> shadow(PROCESS_COUNT, std::vector<uint16_t>(PAGES_PER_PROCESS * FRAME_SIZE / 2, 0));
+
+    RunResult result;
+    std::mt19937 rng(7);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ACCESSES; ++i) {
+        size_t index = rng() % PROCESS_COUNT;
+        Process& process = *processes[index];
+        uint32_t word = rng() % shadow[index].size();
+
+        // A blocked process is retried by its next access, as the scheduler would
+        process.setState(ProcessState::Running);
+        if (rng() % 2) {
+            uint16_t value = static_cast<uint16_t>(rng());
+            if (!memoryManager->writeVirtual(process, word * 2, value)) {
+                ++result.blocked;
+                continue;
+            }
+            shadow[index][word] = value;
+        } else {
+            std::optional<uint16_t> value = memoryManager->readVirtual(process, word * 2);
+            if (!value) {
+                ++result.blocked;
+                continue;
+            }
+            if (*value != shadow[index][word]) ++result.mismatches;
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.faults = memoryManager->getPageFaults();
+    result.hugeFaults = memoryManager->getHugePageFaults();
+    result.pagedIn = memoryManager->getPagesPagedIn();
+
+    for (const auto& process : processes) {
+        memoryManager->freeProcessPages(process->getPID());
+        Process::unregisterProcess(process->getPID());
+    }
+    memoryManager->unregisterTLB(0);
+    memoryManager.reset();
+    MemoryManager::destroy();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    SystemConfig config;
+    config.numCPU = 1;
+    config.memoryPerFrame = FRAME_SIZE;
+    if (argc > 1) config.pageReplacement = argv[1];
+    if (argc > 2) config.backingStore = argv[2];
+    GlobalScheduler::initialize(config);
+
+    std::cout << "policy " << config.pageReplacement << ", store " << config.backingStore << ", "
+              << PROCESS_COUNT << " processes of " << PAGES_PER_PROCESS << " pages, " << FRAME_SIZE
+              << "-byte frames, " << ACCESSES << " accesses per run\n\n";
+    std::cout << std::left << std::setw(8) << "frames" << std::setw(13) << "huge-frames" << std::setw(9) << "faults"
+              << std::setw(13) << "huge-faults" << std::setw(11) << "paged-in" << std::setw(9) << "blocked"
+              << std::setw(12) << "mismatches" << "seconds\n";
+
+    uint64_t totalMismatches = 0;
+    for (uint32_t frames : FRAME_COUNTS) {
+        for (bool hugeFrames : { false, true }) {
+            RunResult result = runWorkload(config, frames, hugeFrames);
+            totalMismatches += result.mismatches;
+
+            std::cout << std::left << std::setw(8) << frames << std::setw(13) << (hugeFrames ? "on" : "off")
+                      << std::setw(9) << result.faults << std::setw(13) << result.hugeFaults << std::setw(11)
+                      << result.pagedIn << std::setw(9) << result.blocked << std::setw(12) << result.mismatches
+                      << std::fixed << std::setprecision(3) << result.seconds << "\n";
+        }
+    }
+
+    GlobalScheduler::destroy();
+    return totalMismatches == 0 ? 0 : 1;
+}